@@ -0,0 +1,17 @@
+#include "benchmark/concurrency/SchedulerBenchmark.h"
+#include "benchmark/pattern/SignalBenchmark.h"
+
+///
+/// @note "signal" as the first argument selects the notification
+///   benchmark; otherwise the scheduler benchmark runs.
+///
+int main(int argc, char **argv)
+{
+  if ((argc > 1) && (RSSD::string_t(argv[1]) == "signal"))
+  {
+    return RSSD::Core::Benchmark::SignalBenchmarkMain(argc - 1, argv + 1);
+  }
+
+  int result = RSSD::Core::Benchmark::SchedulerBenchmarkMain(argc, argv);
+  return result;
+}
@@ -0,0 +1,208 @@
+///
+/// @class SchedulerBenchmark<>::FrameClock
+///
+
+template <typename IMPL>
+void SchedulerBenchmark<IMPL>::FrameClock::reset(const uint32_t frameCount)
+{
+  if (frameCount > this->mFrameCount)
+  {
+    this->mStarts.reset(new std::atomic<uint64_t>[frameCount]);
+    this->mEnds.reset(new std::atomic<uint64_t>[frameCount]);
+    this->mFrameCount = frameCount;
+  }
+  for (uint32_t frame = 0; frame < this->mFrameCount; ++frame)
+  {
+    this->mStarts[frame].store(~0ULL, std::memory_order_relaxed);
+    this->mEnds[frame].store(0, std::memory_order_relaxed);
+  }
+}
+
+///
+/// @note Widens the frame's interval to cover one task execution.
+///
+template <typename IMPL>
+void SchedulerBenchmark<IMPL>::FrameClock::record(const uint64_t frame, const uint64_t start, const uint64_t end)
+{
+  if (frame >= this->mFrameCount) { return; }
+  std::atomic<uint64_t> &first = this->mStarts[frame];
+  std::atomic<uint64_t> &last = this->mEnds[frame];
+  uint64_t value = first.load(std::memory_order_relaxed);
+  while ((start < value) && !first.compare_exchange_weak(value, start, std::memory_order_relaxed)) {}
+  value = last.load(std::memory_order_relaxed);
+  while ((end > value) && !last.compare_exchange_weak(value, end, std::memory_order_relaxed)) {}
+}
+
+template <typename IMPL>
+float64_t SchedulerBenchmark<IMPL>::FrameClock::getMicroseconds(const uint32_t frame) const
+{
+  const uint64_t start = this->mStarts[frame].load(std::memory_order_relaxed);
+  const uint64_t end = this->mEnds[frame].load(std::memory_order_relaxed);
+  return (end > start) ? (static_cast<float64_t>(end - start) / Utilities::Timer::NSEC_PER_USEC) : 0;
+}
+
+///
+/// @class SchedulerBenchmark<>::SpinFunctor
+///
+
+template <typename IMPL>
+typename SchedulerBenchmark<IMPL>::TaskType::OutputType SchedulerBenchmark<IMPL>::SpinFunctor::operator()(
+  typename SchedulerBenchmark<IMPL>::TaskType::InputType input)
+{
+  /// Local vars
+  const uint64_t start = Utilities::BasicTimer::now();
+  const uint64_t duration = this->mMicroseconds * Utilities::Timer::NSEC_PER_USEC;
+  uint64_t now = start;
+
+  while (now - start < duration) { now = Utilities::BasicTimer::now(); }
+  if (this->mClock) { this->mClock->record(input.mIndex, start, now); }
+}
+
+///
+/// @class SchedulerBenchmark<>
+///
+
+template <typename IMPL>
+SchedulerBenchmark<IMPL>::SchedulerBenchmark(const string_t &backend, const Options &options) :
+  mBackend(backend),
+  mOptions(options)
+{
+}
+
+///
+/// @note Registers the graph for the given topology and returns its edge count.
+///
+template <typename IMPL>
+uint32_t SchedulerBenchmark<IMPL>::build(ImplType &impl, const uint32_t topology)
+{
+  /// Local vars
+  const uint32_t taskCount = std::max<uint32_t>(2, this->mOptions.Tasks);
+  const uint32_t stride = Topology::DIAMOND_WIDTH + 1;
+  std::vector<typename TaskType::Pointer> tasks;
+  Random random(this->mOptions.Seed);
+  uint32_t edges = 0;
+
+  tasks.reserve(taskCount);
+  for (uint32_t index = 0; index < taskCount; ++index)
+  {
+    typename TaskType::Pointer task(new TaskType(topology == Topology::FRAME));
+    tasks.push_back(task);
+
+    /// Add the dependencies for the given topology
+    if (index > 0)
+    {
+      switch (topology)
+      {
+        case Topology::CHAIN: { edges += task->addDependency(tasks[index - 1]->getTaskId()); break; }
+        case Topology::FAN: { edges += task->addDependency(tasks[0]->getTaskId()); break; }
+        case Topology::FAN_IN:
+        {
+          if (index + 1 < taskCount) { edges += task->addDependency(tasks[0]->getTaskId()); break; }
+          for (uint32_t parent = 1; parent < index; ++parent)
+          {
+            edges += task->addDependency(tasks[parent]->getTaskId());
+          }
+          break;
+        }
+        case Topology::TREE: { edges += task->addDependency(tasks[(index - 1) / 2]->getTaskId()); break; }
+        case Topology::DIAMOND:
+        case Topology::FRAME:
+        {
+          /// Joins depend on the branches before them, branches on the last join
+          const uint32_t join = index - (index % stride);
+          if (index % stride) { edges += task->addDependency(tasks[join]->getTaskId()); break; }
+          for (uint32_t parent = index - stride + 1; parent < index; ++parent)
+          {
+            edges += task->addDependency(tasks[parent]->getTaskId());
+          }
+          break;
+        }
+        case Topology::RANDOM:
+        {
+          const uint32_t window = std::min(index, Topology::RANDOM_WINDOW);
+          const uint32_t degree = 1 + random.uniform(Topology::RANDOM_DEGREE);
+          for (uint32_t edge = 0; edge < degree; ++edge)
+          {
+            edges += task->addDependency(tasks[index - 1 - random.uniform(window)]->getTaskId());
+          }
+          break;
+        }
+        default: { break; }
+      }
+    }
+
+    /// Vary the cost around the mean
+    const int64_t spread = static_cast<int64_t>(this->mOptions.Cost * this->mOptions.Variation / 100);
+    const int64_t offset = spread ? (static_cast<int64_t>(random.uniform(2 * spread + 1)) - spread) : 0;
+    task->setFunctor(SpinFunctor(
+      static_cast<uint64_t>(std::max<int64_t>(0, this->mOptions.Cost + offset)),
+      (topology == Topology::FRAME) ? &this->mFrameClock : NULL));
+    impl.registerTask(task);
+  }
+  impl.schedule();
+  return edges;
+}
+
+///
+/// @note Times each run from run() to completion. A pipelined run is timed
+///   as a whole for throughput, and each of its frames individually for
+///   the latency percentiles.
+///
+template <typename IMPL>
+Result SchedulerBenchmark<IMPL>::measure(const uint32_t topology, const uint32_t threads)
+{
+  /// Local vars
+  Instance<IMPL> instance(threads);
+  const bool isPipelined = (topology == Topology::FRAME);
+  const uint32_t frames = isPipelined ? std::max<uint32_t>(1, this->mOptions.Frames) : 1;
+  const uint32_t runCount = std::max<uint32_t>(1, this->mOptions.Runs);
+  float64_t_v samples;
+  float64_t total = 0;
+  float64_t latency = 0;
+
+  /// Warm up workers and caches with one untimed run
+  this->mFrameClock.reset(frames);
+  const uint32_t edges = this->build(instance.mImpl, topology);
+  if (isPipelined) { instance.mImpl.pipeline(frames); }
+  else { instance.mImpl.run(); }
+
+  samples.reserve(runCount * frames);
+  for (uint32_t run = 0; run < runCount; ++run)
+  {
+    this->mFrameClock.reset(frames);
+    const uint64_t start = Utilities::BasicTimer::now();
+    if (isPipelined) { instance.mImpl.pipeline(frames); }
+    else { instance.mImpl.run(); }
+    const float64_t microseconds = static_cast<float64_t>(Utilities::BasicTimer::now() - start) / Utilities::Timer::NSEC_PER_USEC;
+    total += microseconds;
+
+    if (!isPipelined)
+    {
+      latency += microseconds;
+      samples.push_back(microseconds);
+      continue;
+    }
+    for (uint32_t frame = 0; frame < frames; ++frame)
+    {
+      const float64_t frameMicroseconds = this->mFrameClock.getMicroseconds(frame);
+      latency += frameMicroseconds;
+      samples.push_back(frameMicroseconds);
+    }
+  }
+  instance.mImpl.clear();
+  std::sort(samples.begin(), samples.end());
+
+  Result result;
+  result.Backend = this->mBackend;
+  result.Topology = topology;
+  result.Threads = threads;
+  result.Tasks = std::max<uint32_t>(2, this->mOptions.Tasks);
+  result.Edges = edges;
+  result.Runs = runCount;
+  result.TasksPerSecond = total ? ((static_cast<float64_t>(result.Tasks) * frames * runCount) / (total / 1000000.0)) : 0;
+  result.MeanMicroseconds = latency / samples.size();
+  result.P50Microseconds = percentile(samples, 0.50);
+  result.P99Microseconds = percentile(samples, 0.99);
+  result.MaxMicroseconds = samples.back();
+  return result;
+}
@@ -0,0 +1,242 @@
+#include "benchmark/concurrency/SchedulerBenchmark.h"
+
+using namespace RSSD;
+using namespace RSSD::Core;
+using namespace RSSD::Core::Benchmark;
+
+namespace {
+
+template <typename IMPL>
+void run(const string_t &backend, const Options &options)
+{
+  SchedulerBenchmark<IMPL> benchmark(backend, options);
+  for (uint32_t topology = Topology::CHAIN; topology < Topology::COUNT; ++topology)
+  {
+    if (options.Topology && (topology != options.Topology)) { continue; }
+
+    /// Powers of two up to the thread limit, and the limit itself
+    for (uint32_t threads = 1; threads <= options.Threads; threads = (threads < options.Threads) ? std::min(threads * 2, options.Threads) : threads + 1)
+    {
+      write(std::cout, benchmark.measure(topology, threads), options.Format);
+      std::cout.flush();
+    }
+  }
+}
+
+} /// namespace
+
+///
+/// @struct Topology
+///
+
+const char* Topology::toString(const uint32_t topology)
+{
+  switch (topology)
+  {
+    case Topology::CHAIN: { return "chain"; }
+    case Topology::FAN: { return "fan"; }
+    case Topology::FAN_IN: { return "fanin"; }
+    case Topology::TREE: { return "tree"; }
+    case Topology::DIAMOND: { return "diamond"; }
+    case Topology::RANDOM: { return "random"; }
+    case Topology::FRAME: { return "frame"; }
+    default: { break; }
+  }
+  return "unknown";
+}
+
+uint32_t Topology::fromString(const string_t &name)
+{
+  for (uint32_t topology = Topology::CHAIN; topology < Topology::COUNT; ++topology)
+  {
+    if (name == Topology::toString(topology)) { return topology; }
+  }
+  return Topology::UNKNOWN;
+}
+
+///
+/// @struct Options
+///
+
+Options::Options() :
+  Backend("all"),
+  Topology(Benchmark::Topology::UNKNOWN),
+  Tasks(1000),
+  Runs(100),
+  Frames(8),
+  Threads(tbb::task_scheduler_init::default_num_threads()),
+  Cost(20),
+  Variation(50),
+  Seed(1),
+  Format(Benchmark::Format::TABLE)
+{
+}
+
+///
+/// @note Accepts --name=value arguments; returns false on anything else.
+///
+bool Options::parse(int argc, char **argv)
+{
+  for (int index = 1; index < argc; ++index)
+  {
+    /// Local vars
+    const string_t argument(argv[index]);
+    const string_t::size_type split = argument.find('=');
+    if ((argument.compare(0, 2, "--") != 0) || (split == string_t::npos)) { return false; }
+    const string_t name = argument.substr(2, split - 2), value = argument.substr(split + 1);
+
+    try
+    {
+      if (name == "backend") { this->Backend = value; }
+      else if (name == "topology") { this->Topology = Benchmark::Topology::fromString(value); if (!this->Topology && (value != "all")) { return false; } }
+      else if (name == "tasks") { this->Tasks = boost::lexical_cast<uint32_t>(value); }
+      else if (name == "runs") { this->Runs = boost::lexical_cast<uint32_t>(value); }
+      else if (name == "frames") { this->Frames = boost::lexical_cast<uint32_t>(value); }
+      else if (name == "threads") { this->Threads = std::max<uint32_t>(1, boost::lexical_cast<uint32_t>(value)); }
+      else if (name == "cost") { this->Cost = boost::lexical_cast<uint64_t>(value); }
+      else if (name == "variation") { this->Variation = std::min<uint32_t>(100, boost::lexical_cast<uint32_t>(value)); }
+      else if (name == "seed") { this->Seed = boost::lexical_cast<uint32_t>(value); }
+      else if (name == "format")
+      {
+        if (value == "table") { this->Format = Benchmark::Format::TABLE; }
+        else if (value == "csv") { this->Format = Benchmark::Format::CSV; }
+        else if (value == "json") { this->Format = Benchmark::Format::JSON; }
+        else { return false; }
+      }
+      else { return false; }
+    }
+    catch (const boost::bad_lexical_cast&)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Options::usage(std::ostream &stream)
+{
+  stream << "Usage: <binary> [--name=value ...]" << std::endl
+    << "  --backend=all|tbb|native" << std::endl
+    << "  --topology=all|chain|fan|fanin|tree|diamond|random|frame" << std::endl
+    << "  --tasks=N          tasks per graph (1000)" << std::endl
+    << "  --runs=N           timed runs per measurement (100)" << std::endl
+    << "  --frames=N         frames per pipelined run (8)" << std::endl
+    << "  --threads=N        largest thread count (hardware threads)" << std::endl
+    << "  --cost=US          mean task cost in microseconds (20)" << std::endl
+    << "  --variation=PCT    task cost spread around the mean (50)" << std::endl
+    << "  --seed=N           graph and cost seed (1)" << std::endl
+    << "  --format=table|csv|json" << std::endl;
+}
+
+///
+/// Global Functions
+///
+
+///
+/// @note Nearest-rank percentile of ascending samples.
+///
+float64_t RSSD::Core::Benchmark::percentile(const float64_t_v &sorted, const float64_t fraction)
+{
+  if (sorted.empty()) { return 0; }
+  const size_t rank = static_cast<size_t>(std::ceil(fraction * sorted.size()));
+  return sorted[std::min(sorted.size(), std::max<size_t>(1, rank)) - 1];
+}
+
+void RSSD::Core::Benchmark::writeHeader(std::ostream &stream, const uint32_t format)
+{
+  switch (format)
+  {
+    case Format::TABLE:
+    {
+      stream << std::setw(8) << "backend"
+        << std::setw(9) << "topology"
+        << std::setw(8) << "threads"
+        << std::setw(8) << "tasks"
+        << std::setw(8) << "edges"
+        << std::setw(6) << "runs"
+        << std::setw(14) << "tasks/s"
+        << std::setw(12) << "mean us"
+        << std::setw(12) << "p50 us"
+        << std::setw(12) << "p99 us"
+        << std::setw(12) << "max us" << std::endl;
+      break;
+    }
+    case Format::CSV:
+    {
+      stream << "backend,topology,threads,tasks,edges,runs,tasks_per_second,mean_us,p50_us,p99_us,max_us" << std::endl;
+      break;
+    }
+    default: { break; }
+  }
+}
+
+void RSSD::Core::Benchmark::write(std::ostream &stream, const Result &result, const uint32_t format)
+{
+  stream << std::fixed << std::setprecision(2);
+  switch (format)
+  {
+    case Format::TABLE:
+    {
+      stream << std::setw(8) << result.Backend
+        << std::setw(9) << Topology::toString(result.Topology)
+        << std::setw(8) << result.Threads
+        << std::setw(8) << result.Tasks
+        << std::setw(8) << result.Edges
+        << std::setw(6) << result.Runs
+        << std::setw(14) << result.TasksPerSecond
+        << std::setw(12) << result.MeanMicroseconds
+        << std::setw(12) << result.P50Microseconds
+        << std::setw(12) << result.P99Microseconds
+        << std::setw(12) << result.MaxMicroseconds << std::endl;
+      break;
+    }
+    case Format::CSV:
+    {
+      stream << result.Backend << ','
+        << Topology::toString(result.Topology) << ','
+        << result.Threads << ','
+        << result.Tasks << ','
+        << result.Edges << ','
+        << result.Runs << ','
+        << result.TasksPerSecond << ','
+        << result.MeanMicroseconds << ','
+        << result.P50Microseconds << ','
+        << result.P99Microseconds << ','
+        << result.MaxMicroseconds << std::endl;
+      break;
+    }
+    case Format::JSON:
+    {
+      stream << "{\"backend\":\"" << result.Backend << '"'
+        << ",\"topology\":\"" << Topology::toString(result.Topology) << '"'
+        << ",\"threads\":" << result.Threads
+        << ",\"tasks\":" << result.Tasks
+        << ",\"edges\":" << result.Edges
+        << ",\"runs\":" << result.Runs
+        << ",\"tasks_per_second\":" << result.TasksPerSecond
+        << ",\"mean_us\":" << result.MeanMicroseconds
+        << ",\"p50_us\":" << result.P50Microseconds
+        << ",\"p99_us\":" << result.P99Microseconds
+        << ",\"max_us\":" << result.MaxMicroseconds << '}' << std::endl;
+      break;
+    }
+    default: { break; }
+  }
+}
+
+int RSSD::Core::Benchmark::SchedulerBenchmarkMain(int argc, char **argv)
+{
+  /// Local vars
+  Options options;
+
+  if (!options.parse(argc, argv))
+  {
+    Options::usage(std::cerr);
+    return 1;
+  }
+
+  writeHeader(std::cout, options.Format);
+  if ((options.Backend == "all") || (options.Backend == "tbb")) { run<Concurrency::Impl::TbbScheduler>("tbb", options); }
+  if ((options.Backend == "all") || (options.Backend == "native")) { run<Concurrency::Impl::NativeScheduler>("native", options); }
+  return 0;
+}
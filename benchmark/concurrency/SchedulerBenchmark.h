@@ -0,0 +1,225 @@
+///
+/// @file SchedulerBenchmark.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by The Secret Design Collective
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+///     this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+///     this list of conditions and the following disclaimer in the documentation
+///     and/or other materials provided with the distribution.
+///    * Neither the name of The Secret Design Collective nor the names of its
+///     contributors may be used to endorse or promote products derived from
+///     this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+#ifndef RSSD_CORE_BENCHMARK_SCHEDULERBENCHMARK_H
+#define RSSD_CORE_BENCHMARK_SCHEDULERBENCHMARK_H
+
+#include <cmath>
+#include <iomanip>
+#include <boost/lexical_cast.hpp>
+#include "System"
+#include "Concurrency"
+#include "Utilities"
+
+namespace RSSD {
+namespace Core {
+namespace Benchmark {
+
+struct Topology
+{
+  enum
+  {
+    UNKNOWN = 0,
+    CHAIN, /// @note Each task depends on the previous one
+    FAN, /// @note One root with every other task depending on it
+    FAN_IN, /// @note One root, a wide middle layer and one sink joining all of it
+    TREE, /// @note Binary tree; task N depends on task (N - 1) / 2
+    DIAMOND, /// @note Stacked diamonds: a fork, DIAMOND_WIDTH branches and a join
+    RANDOM, /// @note Each task depends on up to RANDOM_DEGREE random earlier tasks
+    FRAME, /// @note Recurring diamonds, run as overlapping frames through pipeline()
+    COUNT
+  };
+
+  static const uint32_t DIAMOND_WIDTH = 4;
+  static const uint32_t RANDOM_DEGREE = 3;
+  static const uint32_t RANDOM_WINDOW = 64; /// @note Dependencies are drawn from this many preceding tasks
+
+  static const char* toString(const uint32_t topology);
+  static uint32_t fromString(const string_t &name);
+}; /// struct Topology
+
+struct Format
+{
+  enum
+  {
+    TABLE = 0, /// @note Aligned columns for reading
+    CSV, /// @note One header line, then one line per result
+    JSON, /// @note One JSON object per line
+    COUNT
+  };
+}; /// struct Format
+
+///
+/// @brief Command line settings of the benchmark driver.
+///
+struct Options
+{
+  Options();
+  bool parse(int argc, char **argv);
+  static void usage(std::ostream &stream);
+
+  string_t Backend; /// @note "tbb", "native" or "all"
+  uint32_t Topology; /// @note Topology::UNKNOWN runs every topology
+  uint32_t Tasks;
+  uint32_t Runs; /// @note Timed runs per measurement, after one warm-up run
+  uint32_t Frames; /// @note Frames per pipelined run (Topology::FRAME)
+  uint32_t Threads; /// @note Largest thread count; measured at 1, 2, 4, ... up to it
+  uint64_t Cost; /// @note Mean task cost in microseconds
+  uint32_t Variation; /// @note Task costs vary uniformly by up to this percentage of Cost
+  uint32_t Seed;
+  uint32_t Format;
+}; /// struct Options
+
+struct Result
+{
+  string_t Backend;
+  uint32_t Topology;
+  uint32_t Threads;
+  uint32_t Tasks;
+  uint32_t Edges;
+  uint32_t Runs;
+  float64_t TasksPerSecond;
+  float64_t MeanMicroseconds; /// @note Latency from run() to completion; per frame for Topology::FRAME
+  float64_t P50Microseconds; /// @note Percentiles of the same latency; each frame of Topology::FRAME is one sample
+  float64_t P99Microseconds;
+  float64_t MaxMicroseconds;
+}; /// struct Result
+
+/// @note xorshift32; graphs and costs are reproducible from Options::Seed
+struct Random
+{
+  Random(const uint32_t seed) : mState(seed ? seed : 1) {}
+  FORCE_INLINE uint32_t next()
+  {
+    this->mState ^= this->mState << 13;
+    this->mState ^= this->mState >> 17;
+    this->mState ^= this->mState << 5;
+    return this->mState;
+  }
+  FORCE_INLINE uint32_t uniform(const uint32_t count) { return count ? (this->next() % count) : 0; }
+
+  uint32_t mState;
+}; /// struct Random
+
+///
+/// @brief Owns one scheduler backend limited to a number of threads.
+///
+template <typename IMPL> struct Instance;
+
+template <>
+struct Instance<Concurrency::Impl::TbbScheduler>
+{
+  Instance(const uint32_t threads) : mInit(threads) {}
+
+  tbb::task_scheduler_init mInit; /// @note Constructed first, so that the scheduler runs on it
+  Concurrency::Impl::TbbScheduler mImpl;
+}; /// struct Instance
+
+template <>
+struct Instance<Concurrency::Impl::NativeScheduler>
+{
+  Instance(const uint32_t threads) : mImpl(threads) {}
+
+  Concurrency::Impl::NativeScheduler mImpl;
+}; /// struct Instance
+
+///
+/// @brief Times repeated runs of synthetic task graphs on a scheduler backend.
+/// @note Drives the IMPL directly so that several backends can be
+///   measured side by side in one process.
+///
+template <typename IMPL>
+class SchedulerBenchmark
+{
+public:
+  typedef IMPL ImplType;
+  typedef typename IMPL::TaskType TaskType;
+
+  ///
+  /// @brief Latency of each frame of a pipelined run, from the start of
+  ///   its first task to the end of its last one.
+  /// @note Frames overlap in a pipeline, so they cannot be timed one by
+  ///   one from outside the scheduler; the tasks stamp them instead.
+  ///
+  struct FrameClock : public boost::noncopyable
+  {
+    FrameClock() : mFrameCount(0) {}
+    void reset(const uint32_t frameCount);
+    void record(const uint64_t frame, const uint64_t start, const uint64_t end);
+    float64_t getMicroseconds(const uint32_t frame) const;
+
+    boost::scoped_array<std::atomic<uint64_t> > mStarts; /// @note Nanoseconds
+    boost::scoped_array<std::atomic<uint64_t> > mEnds; /// @note Nanoseconds
+    uint32_t mFrameCount;
+  }; /// struct FrameClock
+
+  /// @note Busy-waits for a fixed number of microseconds
+  struct SpinFunctor
+  {
+    SpinFunctor(const uint64_t microseconds, FrameClock *clock) : mMicroseconds(microseconds), mClock(clock) {}
+    typename TaskType::OutputType operator()(typename TaskType::InputType input);
+
+    uint64_t mMicroseconds;
+    FrameClock *mClock; /// @note Set when the graph runs as a pipeline
+  }; /// struct SpinFunctor
+
+  SchedulerBenchmark(const string_t &backend, const Options &options);
+  Result measure(const uint32_t topology, const uint32_t threads);
+
+protected:
+  uint32_t build(ImplType &impl, const uint32_t topology);
+
+  string_t mBackend;
+  Options mOptions;
+  FrameClock mFrameClock;
+}; /// class SchedulerBenchmark
+
+///
+/// Global Functions
+///
+
+float64_t percentile(const float64_t_v &sorted, const float64_t fraction);
+void writeHeader(std::ostream &stream, const uint32_t format);
+void write(std::ostream &stream, const Result &result, const uint32_t format);
+int SchedulerBenchmarkMain(int argc, char **argv);
+
+///
+/// Includes
+///
+
+#include "benchmark/concurrency/SchedulerBenchmark-inl.h"
+
+} /// namespace Benchmark
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_CORE_BENCHMARK_SCHEDULERBENCHMARK_H
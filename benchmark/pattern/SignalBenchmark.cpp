@@ -0,0 +1,281 @@
+#include "benchmark/pattern/SignalBenchmark.h"
+
+using namespace RSSD;
+using namespace RSSD::Core;
+using namespace RSSD::Core::Benchmark;
+
+///
+/// @struct Mechanism
+///
+
+const char* Mechanism::toString(const uint32_t mechanism)
+{
+  switch (mechanism)
+  {
+    case Mechanism::PUBLISHER: { return "publisher"; }
+    case Mechanism::BATCHED: { return "batched"; }
+    case Mechanism::SIGNAL: { return "signal"; }
+    case Mechanism::SIGNALS2: { return "signals2"; }
+    default: { break; }
+  }
+  return "unknown";
+}
+
+uint32_t Mechanism::fromString(const string_t &name)
+{
+  for (uint32_t mechanism = Mechanism::PUBLISHER; mechanism < Mechanism::COUNT; ++mechanism)
+  {
+    if (name == Mechanism::toString(mechanism)) { return mechanism; }
+  }
+  return Mechanism::UNKNOWN;
+}
+
+///
+/// @struct SignalOptions
+///
+
+SignalOptions::SignalOptions() :
+  Mechanism(Benchmark::Mechanism::UNKNOWN),
+  Subscribers(64),
+  Emits(100000),
+  Batch(64),
+  Format(Benchmark::Format::TABLE)
+{
+}
+
+///
+/// @note Accepts --name=value arguments; returns false on anything else.
+///
+bool SignalOptions::parse(int argc, char **argv)
+{
+  for (int index = 1; index < argc; ++index)
+  {
+    /// Local vars
+    const string_t argument(argv[index]);
+    const string_t::size_type split = argument.find('=');
+    if ((argument.compare(0, 2, "--") != 0) || (split == string_t::npos)) { return false; }
+    const string_t name = argument.substr(2, split - 2), value = argument.substr(split + 1);
+
+    try
+    {
+      if (name == "mechanism") { this->Mechanism = Benchmark::Mechanism::fromString(value); if (!this->Mechanism && (value != "all")) { return false; } }
+      else if (name == "subscribers") { this->Subscribers = std::max<uint32_t>(1, boost::lexical_cast<uint32_t>(value)); }
+      else if (name == "emits") { this->Emits = std::max<uint32_t>(1, boost::lexical_cast<uint32_t>(value)); }
+      else if (name == "batch") { this->Batch = std::max<uint32_t>(1, boost::lexical_cast<uint32_t>(value)); }
+      else if (name == "format")
+      {
+        if (value == "table") { this->Format = Benchmark::Format::TABLE; }
+        else if (value == "csv") { this->Format = Benchmark::Format::CSV; }
+        else if (value == "json") { this->Format = Benchmark::Format::JSON; }
+        else { return false; }
+      }
+      else { return false; }
+    }
+    catch (const boost::bad_lexical_cast&)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void SignalOptions::usage(std::ostream &stream)
+{
+  stream << "Usage: <binary> signal [--name=value ...]" << std::endl
+    << "  --mechanism=all|publisher|batched|signal|signals2" << std::endl
+    << "  --subscribers=N    largest subscriber count (64)" << std::endl
+    << "  --emits=N          notifications per measurement (100000)" << std::endl
+    << "  --batch=N          publications per flush for batched (64)" << std::endl
+    << "  --format=table|csv|json" << std::endl;
+}
+
+///
+/// @struct Counter
+///
+
+void Counter::onNotification(uint64_t &value)
+{
+  this->mSum += value;
+}
+
+void Counter::onValue(uint64_t &value)
+{
+  this->mSum += value;
+}
+
+///
+/// @class SignalBenchmark
+///
+
+SignalBenchmark::SignalBenchmark(const SignalOptions &options) :
+  mOptions(options)
+{
+}
+
+///
+/// @note Connects that many fresh counters to every mechanism, notifies
+///   once to warm up, then times Emits notifications. The result is
+///   invalid if any counter missed a notification; this is checked in
+///   every build, not only with assertions enabled.
+///
+SignalResult SignalBenchmark::measure(const uint32_t mechanism, const uint32_t subscribers)
+{
+  /// Local vars
+  SignalResult result = { mechanism, subscribers, this->mOptions.Emits, 0, 0, true };
+
+  this->mPublisher.reset(new PublisherType());
+  this->mSignal.reset(new SignalType());
+  this->mSignals2.reset(new Signals2Type());
+  this->mCounters.clear();
+  for (uint32_t index = 0; index < subscribers; ++index)
+  {
+    SharedPointer<Counter> counter(new Counter());
+    this->mPublisher->registerSubscriber(counter);
+    this->mSignal->connect(SignalType::DelegateType::bind<Counter, &Counter::onValue>(counter.get()));
+    this->mSignals2->connect(std::tr1::bind(&Counter::onValue, counter.get(), std::tr1::placeholders::_1));
+    this->mCounters.push_back(counter);
+  }
+
+  const uint64_t expected = this->notify(mechanism, 1);
+  const tbb::tick_count start = tbb::tick_count::now();
+  const uint64_t sum = this->notify(mechanism, this->mOptions.Emits) + expected;
+  const float64_t seconds = (tbb::tick_count::now() - start).seconds();
+
+  std::vector<SharedPointer<Counter> >::const_iterator
+    iter = this->mCounters.begin(),
+    end = this->mCounters.end();
+  for (; iter != end; ++iter)
+  {
+    if ((*iter)->mSum != sum) { result.IsValid = false; }
+  }
+
+  const float64_t calls = static_cast<float64_t>(this->mOptions.Emits) * subscribers;
+  result.NanosecondsPerCall = (seconds * 1000000000.0) / calls;
+  result.CallsPerSecond = seconds ? (calls / seconds) : 0;
+  return result;
+}
+
+///
+/// @note Sends 1, 2, ... emits through the mechanism and returns their sum.
+///
+uint64_t SignalBenchmark::notify(const uint32_t mechanism, const uint32_t emits)
+{
+  /// Local vars
+  uint64_t sum = 0;
+
+  for (uint64_t emit = 1; emit <= emits; ++emit)
+  {
+    uint64_t value = emit;
+    sum += value;
+    switch (mechanism)
+    {
+      case Mechanism::PUBLISHER: { this->mPublisher->publish(value); break; }
+      case Mechanism::BATCHED:
+      {
+        this->mPublisher->defer(value);
+        if ((emit % this->mOptions.Batch) == 0) { this->mPublisher->flush(); }
+        break;
+      }
+      case Mechanism::SIGNAL: { this->mSignal->emit(value); break; }
+      case Mechanism::SIGNALS2: { (*this->mSignals2)(value); break; }
+      default: { break; }
+    }
+  }
+  if (mechanism == Mechanism::BATCHED) { this->mPublisher->flush(); }
+  return sum;
+}
+
+///
+/// Global Functions
+///
+
+void RSSD::Core::Benchmark::writeHeader(std::ostream &stream, const SignalOptions &options)
+{
+  switch (options.Format)
+  {
+    case Format::TABLE:
+    {
+      stream << std::setw(10) << "mechanism"
+        << std::setw(13) << "subscribers"
+        << std::setw(10) << "emits"
+        << std::setw(12) << "ns/call"
+        << std::setw(16) << "calls/s" << std::endl;
+      break;
+    }
+    case Format::CSV:
+    {
+      stream << "mechanism,subscribers,emits,ns_per_call,calls_per_second" << std::endl;
+      break;
+    }
+    default: { break; }
+  }
+}
+
+void RSSD::Core::Benchmark::write(std::ostream &stream, const SignalResult &result, const uint32_t format)
+{
+  stream << std::fixed << std::setprecision(2);
+  switch (format)
+  {
+    case Format::TABLE:
+    {
+      stream << std::setw(10) << Mechanism::toString(result.Mechanism)
+        << std::setw(13) << result.Subscribers
+        << std::setw(10) << result.Emits
+        << std::setw(12) << result.NanosecondsPerCall
+        << std::setw(16) << result.CallsPerSecond << std::endl;
+      break;
+    }
+    case Format::CSV:
+    {
+      stream << Mechanism::toString(result.Mechanism) << ','
+        << result.Subscribers << ','
+        << result.Emits << ','
+        << result.NanosecondsPerCall << ','
+        << result.CallsPerSecond << std::endl;
+      break;
+    }
+    case Format::JSON:
+    {
+      stream << "{\"mechanism\":\"" << Mechanism::toString(result.Mechanism) << '"'
+        << ",\"subscribers\":" << result.Subscribers
+        << ",\"emits\":" << result.Emits
+        << ",\"ns_per_call\":" << result.NanosecondsPerCall
+        << ",\"calls_per_second\":" << result.CallsPerSecond << '}' << std::endl;
+      break;
+    }
+    default: { break; }
+  }
+}
+
+int RSSD::Core::Benchmark::SignalBenchmarkMain(int argc, char **argv)
+{
+  /// Local vars
+  SignalOptions options;
+
+  if (!options.parse(argc, argv))
+  {
+    SignalOptions::usage(std::cerr);
+    return 1;
+  }
+
+  SignalBenchmark benchmark(options);
+  writeHeader(std::cout, options);
+  for (uint32_t mechanism = Mechanism::PUBLISHER; mechanism < Mechanism::COUNT; ++mechanism)
+  {
+    if (options.Mechanism && (mechanism != options.Mechanism)) { continue; }
+
+    /// Powers of four up to the subscriber limit, and the limit itself
+    for (uint32_t subscribers = 1; subscribers <= options.Subscribers; subscribers = (subscribers < options.Subscribers) ? std::min(subscribers * 4, options.Subscribers) : subscribers + 1)
+    {
+      const SignalResult result = benchmark.measure(mechanism, subscribers);
+      write(std::cout, result, options.Format);
+      std::cout.flush();
+      if (!result.IsValid)
+      {
+        std::cerr << Mechanism::toString(mechanism) << ": a receiver missed notifications with " << subscribers << " subscribers" << std::endl;
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
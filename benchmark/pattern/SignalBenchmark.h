@@ -0,0 +1,134 @@
+///
+/// @file SignalBenchmark.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by The Secret Design Collective
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+///     this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+///     this list of conditions and the following disclaimer in the documentation
+///     and/or other materials provided with the distribution.
+///    * Neither the name of The Secret Design Collective nor the names of its
+///     contributors may be used to endorse or promote products derived from
+///     this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+#ifndef RSSD_CORE_BENCHMARK_SIGNALBENCHMARK_H
+#define RSSD_CORE_BENCHMARK_SIGNALBENCHMARK_H
+
+#include <boost/signals2.hpp>
+#include "System"
+#include "Pattern"
+#include "benchmark/concurrency/SchedulerBenchmark.h"
+
+namespace RSSD {
+namespace Core {
+namespace Benchmark {
+
+struct Mechanism
+{
+  enum
+  {
+    UNKNOWN = 0,
+    PUBLISHER, /// @note Publisher::publish(); a weak_ptr lock and a virtual call per subscriber
+    BATCHED, /// @note Publisher::defer() and flush(); one lock and virtual call per subscriber per batch
+    SIGNAL, /// @note Pattern::Signal; one direct call through a compile-time thunk per delegate
+    SIGNALS2, /// @note boost::signals2::signal with std::tr1::bind slots
+    COUNT
+  };
+
+  static const char* toString(const uint32_t mechanism);
+  static uint32_t fromString(const string_t &name);
+}; /// struct Mechanism
+
+///
+/// @brief Command line settings of the notification benchmark.
+///
+struct SignalOptions
+{
+  SignalOptions();
+  bool parse(int argc, char **argv);
+  static void usage(std::ostream &stream);
+
+  uint32_t Mechanism; /// @note Mechanism::UNKNOWN runs every mechanism
+  uint32_t Subscribers; /// @note Largest subscriber count; measured at 1, 4, 16, ... up to it
+  uint32_t Emits; /// @note Notifications per measurement, after one warm-up pass
+  uint32_t Batch; /// @note Publications per flush() for Mechanism::BATCHED
+  uint32_t Format;
+}; /// struct SignalOptions
+
+struct SignalResult
+{
+  uint32_t Mechanism;
+  uint32_t Subscribers;
+  uint32_t Emits;
+  float64_t NanosecondsPerCall; /// @note Per subscriber per notification
+  float64_t CallsPerSecond;
+  bool IsValid; /// @note Every receiver saw every notification
+}; /// struct SignalResult
+
+///
+/// @brief Receiver of every mechanism; sums what it is sent.
+///
+struct Counter : public Pattern::Publisher<uint64_t>::Subscriber
+{
+  Counter() : mSum(0) {}
+  virtual void onNotification(uint64_t &value);
+  void onValue(uint64_t &value);
+
+  uint64_t mSum;
+}; /// struct Counter
+
+///
+/// @brief Times notifications of many subscribers through one mechanism.
+///
+class SignalBenchmark
+{
+public:
+  typedef Pattern::Publisher<uint64_t> PublisherType;
+  typedef Pattern::Signal<uint64_t> SignalType;
+  typedef boost::signals2::signal<void (uint64_t&)> Signals2Type;
+
+  SignalBenchmark(const SignalOptions &options);
+  SignalResult measure(const uint32_t mechanism, const uint32_t subscribers);
+
+protected:
+  uint64_t notify(const uint32_t mechanism, const uint32_t emits);
+
+  SignalOptions mOptions;
+  std::vector<SharedPointer<Counter> > mCounters;
+  boost::scoped_ptr<PublisherType> mPublisher;
+  boost::scoped_ptr<SignalType> mSignal;
+  boost::scoped_ptr<Signals2Type> mSignals2;
+}; /// class SignalBenchmark
+
+///
+/// Global Functions
+///
+
+void writeHeader(std::ostream &stream, const SignalOptions &options);
+void write(std::ostream &stream, const SignalResult &result, const uint32_t format);
+int SignalBenchmarkMain(int argc, char **argv);
+
+} /// namespace Benchmark
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_CORE_BENCHMARK_SIGNALBENCHMARK_H
@@ -0,0 +1,120 @@
+#include "concurrency/Completion.h"
+
+using namespace RSSD;
+using namespace RSSD::Core;
+using namespace RSSD::Core::Concurrency;
+
+///
+/// @class Suspension
+///
+
+THREAD_LOCAL Suspension *Suspension::CURRENT = NULL;
+
+void Suspension::bind(const Suspension::ResumeType resume, void *owner, void *context)
+{
+  this->mResume = resume;
+  this->mOwner = owner;
+  this->mContext = context;
+}
+
+///
+/// @note Called by Completion::await() on the thread running the task.
+///
+bool Suspension::suspend(const uint32_t point)
+{
+  if (!this->mResume) { return false; }
+  this->mPoint = point;
+  this->mState.store(State::SUSPENDING, std::memory_order_relaxed);
+  return true;
+}
+
+void Suspension::cancel()
+{
+  this->mState.store(State::NONE, std::memory_order_relaxed);
+}
+
+///
+/// @note Called by Completion::signal(), on any thread. If the task has not
+///   returned yet, the scheduler calls it again as soon as it does.
+///
+void Suspension::resume()
+{
+  uint32_t expected = State::SUSPENDING;
+  if (this->mState.compare_exchange_strong(expected, State::RESUMED, std::memory_order_acq_rel)) { return; }
+  this->mState.store(State::NONE, std::memory_order_relaxed);
+  this->mResume(this->mOwner, this->mContext);
+}
+
+///
+/// @note Called by the scheduler once the task has returned. Returns NONE
+///   if the task completed, SUSPENDED if it waits on a completion, or
+///   RESUMED if it must be called again right away.
+///
+uint32_t Suspension::settle()
+{
+  uint32_t expected = State::SUSPENDING;
+  if (this->mState.compare_exchange_strong(expected, State::SUSPENDED, std::memory_order_acq_rel)) { return State::SUSPENDED; }
+  if (expected == State::RESUMED)
+  {
+    this->mState.store(State::NONE, std::memory_order_relaxed);
+    return State::RESUMED;
+  }
+  this->mPoint = 0;
+  return State::NONE;
+}
+
+///
+/// @class Completion
+///
+
+///
+/// @note Returns true if the result is available and the task may go on.
+///   Returns false if the current task has been suspended; it must then
+///   return at once and will be called again after signal().
+///
+bool Completion::await(const uint32_t point)
+{
+  if (this->isSignalled()) { return true; }
+
+  /// Suspend the current task
+  Suspension *suspension = Suspension::getCurrent();
+  if (suspension && suspension->suspend(point))
+  {
+    this->mWaiter = suspension;
+    uint32_t expected = State::PENDING;
+    if (this->mState.compare_exchange_strong(expected, State::WAITING)) { return false; }
+
+    /// Signalled meanwhile
+    suspension->cancel();
+    return true;
+  }
+
+  /// Block the calling thread
+  this->mBlocked.fetch_add(1);
+  {
+    boost::mutex::scoped_lock lock(this->mMutex);
+    while (!this->isSignalled()) { this->mCondition.wait(lock); }
+  }
+  this->mBlocked.fetch_sub(1);
+  return true;
+}
+
+void Completion::signal()
+{
+  if (this->mState.exchange(State::SIGNALLED) == State::WAITING) { this->mWaiter->resume(); }
+  if (this->mBlocked.load())
+  {
+    boost::mutex::scoped_lock lock(this->mMutex);
+    this->mCondition.notify_all();
+  }
+}
+
+///
+/// @note Makes the completion pending again. Must not race with await() or
+///   signal().
+///
+void Completion::reset()
+{
+  this->mWaiter = NULL;
+  this->mState.store(State::PENDING, std::memory_order_release);
+}
@@ -0,0 +1,152 @@
+///
+/// @file Completion.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by The Secret Design Collective
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+///     this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+///     this list of conditions and the following disclaimer in the documentation
+///     and/or other materials provided with the distribution.
+///    * Neither the name of The Secret Design Collective nor the names of its
+///     contributors may be used to endorse or promote products derived from
+///     this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+
+#ifndef RSSD_CORE_CONCURRENCY_COMPLETION_H
+#define RSSD_CORE_CONCURRENCY_COMPLETION_H
+
+#include "System"
+
+namespace RSSD {
+namespace Core {
+namespace Concurrency {
+
+///
+/// @brief Suspend/resume handshake between a task and the scheduler running it.
+/// @note A scheduler that supports suspension installs one Suspension per
+///   execution as the thread's current suspension while the task runs. A
+///   task suspends by awaiting a pending Completion and returning; once the
+///   completion is signalled, the scheduler calls the task again, on any
+///   worker, and the RSSD_TASK_* macros jump back to the await point.
+///
+class Suspension : public boost::noncopyable
+{
+public:
+  typedef void (*ResumeType)(void *owner, void *context);
+
+  struct State
+  {
+    enum
+    {
+      NONE = 0, /// @note Running or idle; the task has not awaited
+      SUSPENDING, /// @note The task awaited and has not returned yet
+      SUSPENDED, /// @note The task returned and waits for its completion
+      RESUMED /// @note The completion was signalled before the task returned
+    };
+  };
+
+  Suspension() : mResume(NULL), mOwner(NULL), mContext(NULL), mPoint(0), mState(State::NONE) {}
+  void bind(const ResumeType resume, void *owner, void *context);
+  bool suspend(const uint32_t point);
+  void cancel();
+  void resume();
+  uint32_t settle();
+  FORCE_INLINE uint32_t getPoint() const { return this->mPoint; }
+  FORCE_INLINE void reset() { this->mPoint = 0; }
+
+  static FORCE_INLINE Suspension* getCurrent() { return Suspension::CURRENT; }
+  static FORCE_INLINE Suspension* setCurrent(Suspension *suspension)
+  {
+    Suspension *previous = Suspension::CURRENT;
+    Suspension::CURRENT = suspension;
+    return previous;
+  }
+  static FORCE_INLINE uint32_t getCurrentPoint() { return Suspension::CURRENT ? Suspension::CURRENT->mPoint : 0; }
+
+protected:
+  static THREAD_LOCAL Suspension *CURRENT;
+
+  ResumeType mResume;
+  void *mOwner; /// @note Scheduler that resubmits the task
+  void *mContext; /// @note Scheduler record of the suspended execution
+  uint32_t mPoint; /// @note Await point to resume at; zero starts from the top
+  std::atomic<uint32_t> mState;
+}; /// class Suspension
+
+///
+/// @brief One-shot asynchronous result that a task can wait on without
+///   holding a worker, e.g. a Connection::receive() or a file read.
+/// @note At most one task may await a completion at a time. Outside a
+///   scheduler execution that supports suspension (stages of a TBB
+///   pipeline(), plain threads) await() blocks until the completion is
+///   signalled. Tasks of the native backend and of a TBB run() suspend.
+///
+class Completion : public boost::noncopyable
+{
+public:
+  struct State
+  {
+    enum
+    {
+      PENDING = 0,
+      WAITING, /// @note A suspended task is registered
+      SIGNALLED
+    };
+  };
+
+  Completion() : mWaiter(NULL), mState(State::PENDING), mBlocked(0) {}
+  bool await(const uint32_t point = 0);
+  void signal();
+  void reset();
+  FORCE_INLINE bool isSignalled() const { return (this->mState.load(std::memory_order_acquire) == State::SIGNALLED); }
+
+protected:
+  Suspension *mWaiter;
+  std::atomic<uint32_t> mState;
+  std::atomic<uint32_t> mBlocked; /// @note Threads blocked in await()
+  boost::mutex mMutex;
+  boost::condition_variable mCondition;
+}; /// class Completion
+
+} /// namespace Concurrency
+} /// namespace Core
+} /// namespace RSSD
+
+///
+/// @brief Stackless coroutine helpers for task functors.
+/// @note Locals do not survive a suspension; keep state in Ports or in
+///   members indexed by the frame. Example:
+///
+///   void operator()(Frame frame)
+///   {
+///     RSSD_TASK_BEGIN();
+///     this->mConnection.receive(this->mReceived[frame]);
+///     RSSD_TASK_AWAIT(this->mReceived[frame]);
+///     this->process(frame);
+///     RSSD_TASK_END();
+///   }
+///
+#define RSSD_TASK_BEGIN() switch (::RSSD::Core::Concurrency::Suspension::getCurrentPoint()) { case 0:
+#define RSSD_TASK_AWAIT(COMPLETION) do { if (!(COMPLETION).await(__LINE__)) { return; } case __LINE__:; } while (0)
+#define RSSD_TASK_END() }
+
+#endif /// RSSD_CORE_CONCURRENCY_COMPLETION_H
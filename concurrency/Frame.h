@@ -0,0 +1,61 @@
+///
+/// @file Frame.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by The Secret Design Collective
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+///     this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+///     this list of conditions and the following disclaimer in the documentation
+///     and/or other materials provided with the distribution.
+///    * Neither the name of The Secret Design Collective nor the names of its
+///     contributors may be used to endorse or promote products derived from
+///     this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+
+#ifndef RSSD_CORE_CONCURRENCY_FRAME_H
+#define RSSD_CORE_CONCURRENCY_FRAME_H
+
+#include "System"
+
+namespace RSSD {
+namespace Core {
+namespace Concurrency {
+
+///
+/// @brief Identifies the frame a task executes in.
+/// @note Passed to every task as its input. Frames that are in flight at the
+///   same time never share a slot, so a task may index per-frame storage
+///   (see Port) by slot without locking.
+///
+struct Frame
+{
+  Frame(const uint64_t index = 0, const uint32_t slot = 0) : mIndex(index), mSlot(slot) {}
+
+  uint64_t mIndex; /// @note Frame number
+  uint32_t mSlot; /// @note In [0, frames in flight)
+}; /// struct Frame
+
+} /// namespace Concurrency
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_CORE_CONCURRENCY_FRAME_H
@@ -0,0 +1,175 @@
+#include "concurrency/FrameArena.h"
+
+using namespace RSSD;
+using namespace RSSD::Core;
+using namespace RSSD::Core::Concurrency;
+
+///
+/// @class FrameArena
+///
+
+THREAD_LOCAL FrameArena *FrameArena::CURRENT = NULL;
+THREAD_LOCAL uint64_t FrameArena::CACHED_GENERATION = 0;
+THREAD_LOCAL FrameArena::Lane *FrameArena::CACHED_LANE = NULL;
+std::atomic<uint64_t> FrameArena::GENERATION(0);
+
+FrameArena::FrameArena(const uint32_t laneCount, const size_t chunkSize) :
+  mChunkSize(std::max<size_t>(chunkSize, FrameArena::DEFAULT_ALIGNMENT)),
+  mLanes(new Lane[std::max<uint32_t>(1, laneCount)]),
+  mLaneCount(std::max<uint32_t>(1, laneCount)),
+  mClaimed(0),
+  mGeneration(FrameArena::GENERATION.fetch_add(1) + 1),
+  mSharedGeneration(0)
+{
+
+}
+
+FrameArena::~FrameArena()
+{
+  for (uint32_t index = 0; index <= this->mLaneCount; ++index)
+  {
+    const Lane &lane = (index < this->mLaneCount) ? this->mLanes[index] : this->mShared;
+    std::vector<Block>::const_iterator
+      iter = lane.mBlocks.begin(),
+      end = lane.mBlocks.end();
+    for (; iter != end; ++iter)
+    {
+      ::operator delete(iter->mData);
+    }
+  }
+}
+
+///
+/// @note The alignment must be a power of two.
+///
+void* FrameArena::allocate(const size_t size, const size_t alignment)
+{
+  /// Local vars
+  const uint64_t generation = this->mGeneration.load(std::memory_order_acquire);
+
+  /// Claim a lane on this thread's first allocation since the last reset;
+  /// the cache only holds one arena, so look for a lane already claimed
+  /// here before claiming another
+  if (FrameArena::CACHED_GENERATION != generation)
+  {
+    FrameArena::CACHED_LANE = this->find(generation);
+    if (!FrameArena::CACHED_LANE) { FrameArena::CACHED_LANE = this->claim(generation); }
+    FrameArena::CACHED_GENERATION = generation;
+  }
+  if (FrameArena::CACHED_LANE) { return this->allocate(*FrameArena::CACHED_LANE, size, alignment); }
+
+  /// Out of lanes
+  boost::mutex::scoped_lock lock(this->mSharedMutex);
+  if (this->mSharedGeneration != generation)
+  {
+    FrameArena::rewind(this->mShared);
+    this->mSharedGeneration = generation;
+  }
+  return this->allocate(this->mShared, size, alignment);
+}
+
+///
+/// @note Releases every allocation at once. No thread may allocate from
+///   the arena, or still use its memory, while or after it is reset.
+///
+void FrameArena::reset()
+{
+  this->mClaimed.store(0, std::memory_order_relaxed);
+  this->mGeneration.store(FrameArena::GENERATION.fetch_add(1) + 1, std::memory_order_release);
+}
+
+size_t FrameArena::getCapacity() const
+{
+  /// Local vars
+  size_t capacity = 0;
+
+  for (uint32_t index = 0; index <= this->mLaneCount; ++index)
+  {
+    const Lane &lane = (index < this->mLaneCount) ? this->mLanes[index] : this->mShared;
+    std::vector<Block>::const_iterator
+      iter = lane.mBlocks.begin(),
+      end = lane.mBlocks.end();
+    for (; iter != end; ++iter)
+    {
+      capacity += iter->mSize;
+    }
+  }
+  return capacity;
+}
+
+///
+/// @note Returns the lane this thread claimed in the given generation, if
+///   any. Only called when the thread has allocated from another arena
+///   since, or not at all in this generation.
+///
+FrameArena::Lane* FrameArena::find(const uint64_t generation)
+{
+  /// Local vars
+  const void *owner = &FrameArena::CACHED_LANE;
+  const uint32_t claimed = std::min(this->mClaimed.load(std::memory_order_acquire), this->mLaneCount);
+
+  for (uint32_t index = 0; index < claimed; ++index)
+  {
+    const Lane &lane = this->mLanes[index];
+    if ((lane.mGeneration.load(std::memory_order_acquire) == generation) && (lane.mOwner.load(std::memory_order_relaxed) == owner))
+    {
+      return &this->mLanes[index];
+    }
+  }
+  return NULL;
+}
+
+FrameArena::Lane* FrameArena::claim(const uint64_t generation)
+{
+  const uint32_t index = this->mClaimed.fetch_add(1, std::memory_order_acq_rel);
+  if (index >= this->mLaneCount) { return NULL; }
+  Lane &lane = this->mLanes[index];
+  FrameArena::rewind(lane);
+  lane.mOwner.store(&FrameArena::CACHED_LANE, std::memory_order_relaxed);
+  lane.mGeneration.store(generation, std::memory_order_release);
+  return &lane;
+}
+
+///
+/// @note Moves on to the next kept block that is large enough, and only
+///   allocates a block when there is none.
+///
+void* FrameArena::allocate(FrameArena::Lane &lane, const size_t size, const size_t alignment)
+{
+  /// Local vars
+  const size_t mask = alignment - 1;
+  const size_t required = std::max<size_t>(1, size);
+
+  /// Bump the cursor
+  char *aligned = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(lane.mCursor) + mask) & ~mask);
+  if (lane.mCursor && (aligned + required <= lane.mEnd))
+  {
+    lane.mCursor = aligned + required;
+    return aligned;
+  }
+
+  /// Reuse a kept block, or add one
+  size_t next = lane.mBlocks.empty() ? 0 : (lane.mBlock + 1);
+  while ((next < lane.mBlocks.size()) && (lane.mBlocks[next].mSize < required + mask)) { ++next; }
+  if (next == lane.mBlocks.size())
+  {
+    Block block;
+    block.mSize = std::max(this->mChunkSize, required + mask);
+    block.mData = static_cast<char*>(::operator new(block.mSize));
+    lane.mBlocks.push_back(block);
+  }
+  lane.mBlock = next;
+  lane.mCursor = lane.mBlocks[next].mData;
+  lane.mEnd = lane.mCursor + lane.mBlocks[next].mSize;
+
+  aligned = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(lane.mCursor) + mask) & ~mask);
+  lane.mCursor = aligned + required;
+  return aligned;
+}
+
+void FrameArena::rewind(FrameArena::Lane &lane)
+{
+  lane.mBlock = 0;
+  lane.mCursor = lane.mBlocks.empty() ? NULL : lane.mBlocks[0].mData;
+  lane.mEnd = lane.mBlocks.empty() ? NULL : (lane.mCursor + lane.mBlocks[0].mSize);
+}
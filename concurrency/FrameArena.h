@@ -0,0 +1,165 @@
+///
+/// @file FrameArena.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by The Secret Design Collective
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+///     this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+///     this list of conditions and the following disclaimer in the documentation
+///     and/or other materials provided with the distribution.
+///    * Neither the name of The Secret Design Collective nor the names of its
+///     contributors may be used to endorse or promote products derived from
+///     this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+
+#ifndef RSSD_CORE_CONCURRENCY_FRAMEARENA_H
+#define RSSD_CORE_CONCURRENCY_FRAMEARENA_H
+
+#include "System"
+
+namespace RSSD {
+namespace Core {
+namespace Concurrency {
+
+///
+/// @brief Linear allocator for the temporaries of one frame.
+/// @note Every thread that allocates claims a lane of its own, so threads
+///   never contend; threads beyond the lane count share one lane under a
+///   lock. Memory is never freed individually. reset() releases all of it
+///   at once in O(1), and the blocks are kept for the next frame. The
+///   schedulers keep one arena per frame slot and reset it as the frame in
+///   the slot retires; while a task runs, the arena of its frame is current
+///   on that thread.
+///
+class FrameArena : public boost::noncopyable
+{
+public:
+  FrameArena(const uint32_t laneCount = 1, const size_t chunkSize = FrameArena::DEFAULT_CHUNK_SIZE);
+  ~FrameArena();
+  void* allocate(const size_t size, const size_t alignment = FrameArena::DEFAULT_ALIGNMENT);
+  template <typename T> FORCE_INLINE T* allocate(const size_t count = 1)
+  {
+    return static_cast<T*>(this->allocate(sizeof(T) * count, boost::alignment_of<T>::value));
+  }
+  void reset();
+  size_t getCapacity() const;
+
+  static FORCE_INLINE FrameArena* getCurrent() { return FrameArena::CURRENT; }
+  static FORCE_INLINE FrameArena* setCurrent(FrameArena *arena)
+  {
+    FrameArena *previous = FrameArena::CURRENT;
+    FrameArena::CURRENT = arena;
+    return previous;
+  }
+
+  static const size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+  static const size_t DEFAULT_ALIGNMENT = 16;
+
+protected:
+  struct Block
+  {
+    char *mData;
+    size_t mSize;
+  }; /// struct Block
+
+  struct Lane
+  {
+    Lane() : mCursor(NULL), mEnd(NULL), mBlock(0), mOwner(NULL), mGeneration(0) {}
+
+    char *mCursor;
+    char *mEnd;
+    size_t mBlock; /// @note Block the cursor is in
+    std::vector<Block> mBlocks; /// @note Kept across resets
+    std::atomic<const void*> mOwner; /// @note Thread that claimed the lane, as the address of its CACHED_LANE
+    std::atomic<uint64_t> mGeneration; /// @note Generation the lane was claimed in
+  }; /// struct Lane
+
+  Lane* find(const uint64_t generation);
+  Lane* claim(const uint64_t generation);
+  void* allocate(Lane &lane, const size_t size, const size_t alignment);
+  static void rewind(Lane &lane);
+
+  static THREAD_LOCAL FrameArena *CURRENT;
+  static THREAD_LOCAL uint64_t CACHED_GENERATION; /// @note Generation the cached lane was claimed in
+  static THREAD_LOCAL Lane *CACHED_LANE; /// @note Last lane used by this thread, in any arena
+  static std::atomic<uint64_t> GENERATION; /// @note Unique across arenas, so a cached lane never matches another arena
+
+  size_t mChunkSize;
+  boost::scoped_array<Lane> mLanes;
+  uint32_t mLaneCount;
+  std::atomic<uint32_t> mClaimed; /// @note Lanes claimed in this generation
+  std::atomic<uint64_t> mGeneration;
+  Lane mShared; /// @note Used once every lane has been claimed
+  uint64_t mSharedGeneration;
+  boost::mutex mSharedMutex;
+}; /// class FrameArena
+
+///
+/// @brief Standard allocator on a FrameArena, for containers of task temporaries.
+/// @note Defaults to the current arena; deallocation is a no-op. Without an
+///   arena, such as outside a task, it falls back to the global heap like
+///   std::allocator. Example:
+///
+///   std::vector<Contact, ArenaAllocator<Contact> > contacts;
+///
+template <typename T>
+class ArenaAllocator
+{
+public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  template <typename U> struct rebind { typedef ArenaAllocator<U> other; };
+
+  ArenaAllocator(FrameArena *arena = FrameArena::getCurrent()) : mArena(arena) {}
+  template <typename U> ArenaAllocator(const ArenaAllocator<U> &rhs) : mArena(rhs.getArena()) {}
+  FORCE_INLINE FrameArena* getArena() const { return this->mArena; }
+  FORCE_INLINE pointer allocate(const size_type count, const void *hint = NULL)
+  {
+    if (!this->mArena) { return static_cast<pointer>(::operator new(sizeof(T) * count)); }
+    return this->mArena->template allocate<T>(count);
+  }
+  FORCE_INLINE void deallocate(pointer object, const size_type count)
+  {
+    if (!this->mArena) { ::operator delete(object); }
+  }
+  FORCE_INLINE size_type max_size() const { return static_cast<size_type>(-1) / sizeof(T); }
+  FORCE_INLINE void construct(pointer object, const T &value) { new (object) T(value); }
+  FORCE_INLINE void destroy(pointer object) { object->~T(); }
+  FORCE_INLINE pointer address(reference value) const { return &value; }
+  FORCE_INLINE const_pointer address(const_reference value) const { return &value; }
+  template <typename U> FORCE_INLINE bool operator==(const ArenaAllocator<U> &rhs) const { return (this->mArena == rhs.getArena()); }
+  template <typename U> FORCE_INLINE bool operator!=(const ArenaAllocator<U> &rhs) const { return (this->mArena != rhs.getArena()); }
+
+protected:
+  FrameArena *mArena;
+}; /// class ArenaAllocator
+
+} /// namespace Concurrency
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_CORE_CONCURRENCY_FRAMEARENA_H
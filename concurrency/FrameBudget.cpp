@@ -0,0 +1,82 @@
+#include "concurrency/FrameBudget.h"
+#include "concurrency/Task.h"
+
+using namespace RSSD;
+using namespace RSSD::Core;
+using namespace RSSD::Core::Concurrency;
+
+///
+/// @class FrameBudget
+///
+
+FrameBudget::FrameBudget() :
+  mBudget(0),
+  mFrames(0),
+  mOverruns(0),
+  mDeadlineMisses(0),
+  mShed(0),
+  mWorstFrame(0)
+{
+
+}
+
+FrameBudget::Report FrameBudget::getReport() const
+{
+  Report report;
+  report.mFrames = this->mFrames.load(std::memory_order_relaxed);
+  report.mOverruns = this->mOverruns.load(std::memory_order_relaxed);
+  report.mDeadlineMisses = this->mDeadlineMisses.load(std::memory_order_relaxed);
+  report.mShed = this->mShed.load(std::memory_order_relaxed);
+  report.mWorstFrame = this->mWorstFrame.load(std::memory_order_relaxed);
+  return report;
+}
+
+void FrameBudget::resetReport()
+{
+  this->mFrames.store(0, std::memory_order_relaxed);
+  this->mOverruns.store(0, std::memory_order_relaxed);
+  this->mDeadlineMisses.store(0, std::memory_order_relaxed);
+  this->mShed.store(0, std::memory_order_relaxed);
+  this->mWorstFrame.store(0, std::memory_order_relaxed);
+}
+
+///
+/// @note Called before a task runs. Returns true if the task should skip
+///   this frame. deferredFrames is the number of frames the task has
+///   skipped in a row; the caller keeps count.
+///
+bool FrameBudget::shed(
+  const uint64_t frameStart,
+  const uint64_t criticalPath,
+  const uint32_t priority,
+  const bool isRecurring,
+  const uint32_t deferredFrames)
+{
+  /// Local vars
+  const uint64_t budget = this->mBudget;
+
+  if (!budget || !isRecurring || (priority > Task::Priority::LOW)) { return false; }
+  if (deferredFrames >= FrameBudget::MAX_DEFERRED_FRAMES) { return false; }
+  if (FrameBudget::now() - frameStart + criticalPath <= budget) { return false; }
+
+  this->mShed.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void FrameBudget::completeTask(const uint64_t frameStart, const uint64_t deadline)
+{
+  if (deadline && (FrameBudget::now() - frameStart > deadline)) { this->mDeadlineMisses.fetch_add(1, std::memory_order_relaxed); }
+}
+
+void FrameBudget::completeFrame(const uint64_t frameStart)
+{
+  /// Local vars
+  const uint64_t elapsed = FrameBudget::now() - frameStart;
+  const uint64_t budget = this->mBudget;
+
+  this->mFrames.fetch_add(1, std::memory_order_relaxed);
+  if (budget && (elapsed > budget)) { this->mOverruns.fetch_add(1, std::memory_order_relaxed); }
+
+  uint64_t worst = this->mWorstFrame.load(std::memory_order_relaxed);
+  while ((elapsed > worst) && !this->mWorstFrame.compare_exchange_weak(worst, elapsed, std::memory_order_relaxed)) {}
+}
@@ -0,0 +1,91 @@
+///
+/// @file FrameBudget.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by The Secret Design Collective
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+///     this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+///     this list of conditions and the following disclaimer in the documentation
+///     and/or other materials provided with the distribution.
+///    * Neither the name of The Secret Design Collective nor the names of its
+///     contributors may be used to endorse or promote products derived from
+///     this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+
+#ifndef RSSD_CORE_CONCURRENCY_FRAMEBUDGET_H
+#define RSSD_CORE_CONCURRENCY_FRAMEBUDGET_H
+
+#include "System"
+#include "Utilities"
+
+namespace RSSD {
+namespace Core {
+namespace Concurrency {
+
+///
+/// @brief Time budget of one frame, and the overruns against it.
+/// @note A frame is at risk once the time it has used plus the measured
+///   critical path still ahead of a task exceeds the budget. Scheduler
+///   backends then shed LOW-priority recurring tasks: the task skips this
+///   frame and runs again in the next one. No task is shed more than
+///   MAX_DEFERRED_FRAMES frames in a row. Its successors are released as
+///   usual. All times are in microseconds.
+///
+class FrameBudget : public boost::noncopyable
+{
+public:
+  struct Report
+  {
+    Report() : mFrames(0), mOverruns(0), mDeadlineMisses(0), mShed(0), mWorstFrame(0) {}
+
+    uint64_t mFrames; /// @note Frames completed
+    uint64_t mOverruns; /// @note Frames that took longer than the budget
+    uint64_t mDeadlineMisses; /// @note Tasks that completed after their deadline
+    uint64_t mShed; /// @note Task executions skipped to protect the budget
+    uint64_t mWorstFrame; /// @note Longest frame
+  }; /// struct Report
+
+  FrameBudget();
+  DEFINE_PROPERTY_INLINE_VOLATILE(uint64_t, Budget, mBudget); /// @note Zero disables shedding and overrun reports
+  Report getReport() const;
+  void resetReport();
+  bool shed(const uint64_t frameStart, const uint64_t criticalPath, const uint32_t priority, const bool isRecurring, const uint32_t deferredFrames);
+  void completeTask(const uint64_t frameStart, const uint64_t deadline);
+  void completeFrame(const uint64_t frameStart);
+  static FORCE_INLINE uint64_t now() { return Utilities::BasicTimer::now() / Utilities::Timer::NSEC_PER_USEC; } /// @note Microseconds
+
+  static const uint32_t MAX_DEFERRED_FRAMES = 4;
+
+protected:
+  volatile uint64_t mBudget;
+  std::atomic<uint64_t> mFrames;
+  std::atomic<uint64_t> mOverruns;
+  std::atomic<uint64_t> mDeadlineMisses;
+  std::atomic<uint64_t> mShed;
+  std::atomic<uint64_t> mWorstFrame;
+}; /// class FrameBudget
+
+} /// namespace Concurrency
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_CORE_CONCURRENCY_FRAMEBUDGET_H
@@ -0,0 +1,67 @@
+///
+/// @class InlineFunctor<>::Inline<>
+///
+
+template <typename OUTPUT, typename INPUT>
+template <typename FUNCTOR>
+const typename InlineFunctor<OUTPUT, INPUT>::Operations InlineFunctor<OUTPUT, INPUT>::Inline<FUNCTOR>::OPERATIONS =
+{
+  &InlineFunctor<OUTPUT, INPUT>::Inline<FUNCTOR>::invoke,
+  &InlineFunctor<OUTPUT, INPUT>::Inline<FUNCTOR>::copy,
+  &InlineFunctor<OUTPUT, INPUT>::Inline<FUNCTOR>::destroy
+};
+
+///
+/// @class InlineFunctor<>::Heap<>
+///
+
+template <typename OUTPUT, typename INPUT>
+template <typename FUNCTOR>
+const typename InlineFunctor<OUTPUT, INPUT>::Operations InlineFunctor<OUTPUT, INPUT>::Heap<FUNCTOR>::OPERATIONS =
+{
+  &InlineFunctor<OUTPUT, INPUT>::Heap<FUNCTOR>::invoke,
+  &InlineFunctor<OUTPUT, INPUT>::Heap<FUNCTOR>::copy,
+  &InlineFunctor<OUTPUT, INPUT>::Heap<FUNCTOR>::destroy
+};
+
+///
+/// @class InlineFunctor<>
+///
+
+template <typename OUTPUT, typename INPUT>
+InlineFunctor<OUTPUT, INPUT>::InlineFunctor(const InlineFunctor<OUTPUT, INPUT> &rhs) :
+  mOperations(rhs.mOperations)
+{
+  if (this->mOperations) { this->mOperations->mCopy(&this->mStorage, rhs.mStorage); }
+}
+
+template <typename OUTPUT, typename INPUT>
+template <typename FUNCTOR>
+InlineFunctor<OUTPUT, INPUT>::InlineFunctor(const FUNCTOR &functor)
+{
+  if (IsInline<FUNCTOR>::VALUE)
+  {
+    new (this->mStorage.mBytes) FUNCTOR(functor);
+    this->mOperations = &Inline<FUNCTOR>::OPERATIONS;
+    return;
+  }
+
+  this->mStorage.mPointer = new FUNCTOR(functor);
+  this->mOperations = &Heap<FUNCTOR>::OPERATIONS;
+}
+
+template <typename OUTPUT, typename INPUT>
+InlineFunctor<OUTPUT, INPUT>::~InlineFunctor()
+{
+  if (this->mOperations) { this->mOperations->mDestroy(&this->mStorage); }
+}
+
+template <typename OUTPUT, typename INPUT>
+InlineFunctor<OUTPUT, INPUT>& InlineFunctor<OUTPUT, INPUT>::operator =(const InlineFunctor<OUTPUT, INPUT> &rhs)
+{
+  if (this == &rhs) { return *this; }
+  if (this->mOperations) { this->mOperations->mDestroy(&this->mStorage); }
+  this->mOperations = rhs.mOperations;
+  if (this->mOperations) { this->mOperations->mCopy(&this->mStorage, rhs.mStorage); }
+  return *this;
+}
@@ -0,0 +1,122 @@
+///
+/// @file InlineFunctor.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by The Secret Design Collective
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+///     this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+///     this list of conditions and the following disclaimer in the documentation
+///     and/or other materials provided with the distribution.
+///    * Neither the name of The Secret Design Collective nor the names of its
+///     contributors may be used to endorse or promote products derived from
+///     this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+
+#ifndef RSSD_CORE_CONCURRENCY_INLINEFUNCTOR_H
+#define RSSD_CORE_CONCURRENCY_INLINEFUNCTOR_H
+
+#include "System"
+
+namespace RSSD {
+namespace Core {
+namespace Concurrency {
+
+///
+/// @brief Type-erased callable OUTPUT(INPUT) with inline storage.
+/// @note Callables of up to CAPACITY bytes (function pointers, small
+///   functors, bound member pointers) are stored in place, so construction,
+///   copy and assignment do not allocate. Larger callables fall back to the
+///   heap.
+///
+template <typename OUTPUT, typename INPUT>
+class InlineFunctor
+{
+public:
+  InlineFunctor() : mOperations(NULL) {}
+  InlineFunctor(const InlineFunctor &rhs);
+  template <typename FUNCTOR> InlineFunctor(const FUNCTOR &functor);
+  ~InlineFunctor();
+  InlineFunctor& operator =(const InlineFunctor &rhs);
+  FORCE_INLINE OUTPUT operator()(INPUT input) const { return this->mOperations->mInvoke(const_cast<Storage*>(&this->mStorage), input); }
+  FORCE_INLINE bool empty() const { return !this->mOperations; }
+
+  static const size_t CAPACITY = 6 * sizeof(void*);
+
+protected:
+  union Storage
+  {
+    char mBytes[CAPACITY];
+    void *mPointer;
+    uint64_t mInteger;
+    float64_t mFloat;
+  }; /// union Storage
+
+  struct Operations
+  {
+    OUTPUT (*mInvoke)(Storage *storage, INPUT input);
+    void (*mCopy)(Storage *target, const Storage &source);
+    void (*mDestroy)(Storage *storage);
+  }; /// struct Operations
+
+  /// @note Operations for a callable stored in place
+  template <typename FUNCTOR>
+  struct Inline
+  {
+    static OUTPUT invoke(Storage *storage, INPUT input) { return (*reinterpret_cast<FUNCTOR*>(storage->mBytes))(input); }
+    static void copy(Storage *target, const Storage &source) { new (target->mBytes) FUNCTOR(*reinterpret_cast<const FUNCTOR*>(source.mBytes)); }
+    static void destroy(Storage *storage) { reinterpret_cast<FUNCTOR*>(storage->mBytes)->~FUNCTOR(); }
+    static const Operations OPERATIONS;
+  }; /// struct Inline
+
+  /// @note Operations for a callable too large for the inline storage
+  template <typename FUNCTOR>
+  struct Heap
+  {
+    static OUTPUT invoke(Storage *storage, INPUT input) { return (*static_cast<FUNCTOR*>(storage->mPointer))(input); }
+    static void copy(Storage *target, const Storage &source) { target->mPointer = new FUNCTOR(*static_cast<const FUNCTOR*>(source.mPointer)); }
+    static void destroy(Storage *storage) { delete static_cast<FUNCTOR*>(storage->mPointer); }
+    static const Operations OPERATIONS;
+  }; /// struct Heap
+
+  template <typename FUNCTOR>
+  struct IsInline
+  {
+    static const bool VALUE =
+      (sizeof(FUNCTOR) <= CAPACITY) &&
+      ((boost::alignment_of<Storage>::value % boost::alignment_of<FUNCTOR>::value) == 0);
+  }; /// struct IsInline
+
+  Storage mStorage;
+  const Operations *mOperations;
+}; /// class InlineFunctor
+
+///
+/// Includes
+///
+
+#include "concurrency/InlineFunctor-inl.h"
+
+} /// namespace Concurrency
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_CORE_CONCURRENCY_INLINEFUNCTOR_H
@@ -0,0 +1,50 @@
+///
+/// @class Port
+///
+
+template <typename T>
+Port<T>::Port(const uint32_t slotCount) :
+  mValues(new T[std::max<uint32_t>(1, slotCount)]),
+  mSlotCount(std::max<uint32_t>(1, slotCount)),
+  mProducerId(0),
+  mProducerVersion(NULL)
+{
+
+}
+
+///
+/// @note Discards all values; must only be called while no frame is in flight.
+///
+template <typename T>
+void Port<T>::resize(const uint32_t slotCount)
+{
+  this->mSlotCount = std::max<uint32_t>(1, slotCount);
+  this->mValues.reset(new T[this->mSlotCount]);
+}
+
+///
+/// @note Keeps the producer's output version by address, so the producer
+///   must outlive the consumers connected to the Port.
+///
+template <typename T>
+template <typename TASK>
+void Port<T>::setProducer(const TASK &producer)
+{
+  this->mProducerId = producer.getTaskId();
+  this->mProducerVersion = &producer.getOutputVersion();
+}
+
+///
+/// @note Adds the edge from the producer to the consumer; call it before
+///   the consumer is registered. Returns false if the Port has no
+///   producer, or the consumer already depends on it.
+///
+template <typename T>
+template <typename TASK>
+bool Port<T>::connect(TASK &consumer) const
+{
+  if (!this->mProducerVersion) { return false; }
+  if (!consumer.addDependency(this->mProducerId)) { return false; }
+  consumer.addInput(*this->mProducerVersion);
+  return true;
+}
@@ -0,0 +1,98 @@
+///
+/// @file Port.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by The Secret Design Collective
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+///     this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+///     this list of conditions and the following disclaimer in the documentation
+///     and/or other materials provided with the distribution.
+///    * Neither the name of The Secret Design Collective nor the names of its
+///     contributors may be used to endorse or promote products derived from
+///     this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+
+#ifndef RSSD_CORE_CONCURRENCY_PORT_H
+#define RSSD_CORE_CONCURRENCY_PORT_H
+
+#include "System"
+#include "concurrency/Frame.h"
+#include "concurrency/Version.h"
+
+namespace RSSD {
+namespace Core {
+namespace Concurrency {
+
+///
+/// @brief Typed, preallocated hand-off between a producer task and the
+///   tasks that depend on it.
+/// @note Holds one value per frame slot. The producer writes the value of
+///   its frame in place (or moves one in); consumers read it by reference
+///   once the dependency edge has released them. The edge orders the two
+///   sides, and a slot is only reused once its frame has completed, so no
+///   locking is needed. Values are never copied by the Port itself, and
+///   values that keep their capacity (e.g. a cleared vector) do not
+///   allocate from one frame to the next.
+/// @note The slot count must be at least the scheduler's frames in flight;
+///   a slot beyond it would silently share another frame's value, so the
+///   accessors assert on it.
+/// @note The Port is the typed output of its producer: connect() makes a
+///   consumer depend on the producer and take the producer's output
+///   version as an input, so the edge that orders the two sides is the
+///   one the value travels along. Tasks themselves stay (Frame) -> void,
+///   which keeps one functor type, and one scheduler, for every payload.
+///
+template <typename T>
+class Port : public boost::noncopyable
+{
+public:
+  typedef T ValueType;
+
+  Port(const uint32_t slotCount = 1);
+  void resize(const uint32_t slotCount);
+  template <typename TASK> void setProducer(const TASK &producer);
+  template <typename TASK> bool connect(TASK &consumer) const;
+  FORCE_INLINE uint32_t getProducerId() const { return this->mProducerId; }
+  FORCE_INLINE uint32_t getSlotCount() const { return this->mSlotCount; }
+  FORCE_INLINE T& operator[](const Frame &frame) { assert(frame.mSlot < this->mSlotCount); return this->mValues[frame.mSlot]; }
+  FORCE_INLINE const T& operator[](const Frame &frame) const { assert(frame.mSlot < this->mSlotCount); return this->mValues[frame.mSlot]; }
+  FORCE_INLINE void put(const Frame &frame, T &&value) { (*this)[frame] = std::move(value); }
+  FORCE_INLINE T take(const Frame &frame) { return std::move((*this)[frame]); }
+
+protected:
+  boost::scoped_array<T> mValues;
+  uint32_t mSlotCount;
+  uint32_t mProducerId; /// @note Zero until setProducer()
+  const Version *mProducerVersion; /// @note Output version of the producer
+}; /// class Port
+
+///
+/// Includes
+///
+
+#include "concurrency/Port-inl.h"
+
+} /// namespace Concurrency
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_CORE_CONCURRENCY_PORT_H
@@ -0,0 +1,80 @@
+#include "concurrency/RunHandle.h"
+
+using namespace RSSD;
+using namespace RSSD::Core;
+using namespace RSSD::Core::Concurrency;
+
+///
+/// @class RunTracker
+///
+
+///
+/// @note Returns the number of the new run. The previous run must have completed.
+///
+uint64_t RunTracker::begin()
+{
+  return this->mStarted.fetch_add(1, std::memory_order_acq_rel) + 1;
+}
+
+///
+/// @note Completes the current run, and queues its continuations for
+///   callContinuations().
+///
+bool RunTracker::complete()
+{
+  boost::mutex::scoped_lock lock(this->mMutex);
+  this->mCompleted.store(this->mStarted.load(std::memory_order_relaxed), std::memory_order_release);
+  if (this->mContinuations.empty()) { return false; }
+  if (this->mReady.empty())
+  {
+    this->mReady.swap(this->mContinuations);
+    return true;
+  }
+  this->mReady.insert(this->mReady.end(), this->mContinuations.begin(), this->mContinuations.end());
+  this->mContinuations.clear();
+  return true;
+}
+
+///
+/// @note Calls the queued continuations without holding the lock, so they
+///   may register continuations or start the next run. Storage is handed
+///   back and forth between the lists, so steady-state calls do not
+///   allocate.
+///
+void RunTracker::callContinuations()
+{
+  /// Local vars
+  std::vector<Continuation> calling;
+
+  boost::mutex::scoped_lock lock(this->mMutex);
+  calling.swap(this->mCalling);
+  while (!this->mReady.empty())
+  {
+    calling.swap(this->mReady);
+    lock.unlock();
+
+    std::vector<Continuation>::const_iterator
+      iter = calling.begin(),
+      end = calling.end();
+    for (; iter != end; ++iter)
+    {
+      iter->mContinuation(iter->mContext);
+    }
+    calling.clear();
+    lock.lock();
+  }
+  if (calling.capacity() > this->mCalling.capacity()) { this->mCalling.swap(calling); }
+}
+
+void RunTracker::then(const uint64_t run, const RunTracker::ContinuationType continuation, void *context)
+{
+  boost::mutex::scoped_lock lock(this->mMutex);
+  if (!this->isComplete(run))
+  {
+    Continuation entry = { continuation, context };
+    this->mContinuations.push_back(entry);
+    return;
+  }
+  lock.unlock();
+  continuation(context);
+}
@@ -0,0 +1,124 @@
+///
+/// @file RunHandle.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by The Secret Design Collective
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+///     this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+///     this list of conditions and the following disclaimer in the documentation
+///     and/or other materials provided with the distribution.
+///    * Neither the name of The Secret Design Collective nor the names of its
+///     contributors may be used to endorse or promote products derived from
+///     this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+
+#ifndef RSSD_CORE_CONCURRENCY_RUNHANDLE_H
+#define RSSD_CORE_CONCURRENCY_RUNHANDLE_H
+
+#include "System"
+
+namespace RSSD {
+namespace Core {
+namespace Concurrency {
+
+///
+/// @brief Numbers the runs of one scheduler and calls the continuations
+///   registered for them.
+/// @note Runs of a scheduler complete in the order they were started.
+///   Continuations are called after the run counts as complete, so they
+///   may start the next run. complete() hands them to the backend, which
+///   calls them through callContinuations().
+///
+class RunTracker : public boost::noncopyable
+{
+public:
+  typedef void (*ContinuationType)(void *context);
+
+  RunTracker() : mStarted(0), mCompleted(0) {}
+  uint64_t begin();
+  bool complete(); /// @note Returns true if continuations are waiting to be called
+  void callContinuations();
+  void then(const uint64_t run, const ContinuationType continuation, void *context);
+  FORCE_INLINE uint64_t getCurrent() const { return this->mStarted.load(std::memory_order_acquire); }
+  FORCE_INLINE bool isComplete(const uint64_t run) const { return (this->mCompleted.load(std::memory_order_acquire) >= run); }
+
+  static const uint64_t INFINITE = ~0ULL; /// @note Timeout that never expires
+
+protected:
+  struct Continuation
+  {
+    ContinuationType mContinuation;
+    void *mContext;
+  }; /// struct Continuation
+
+  std::atomic<uint64_t> mStarted;
+  std::atomic<uint64_t> mCompleted;
+  boost::mutex mMutex;
+  std::vector<Continuation> mContinuations; /// @note Registered for the current run
+  std::vector<Continuation> mReady; /// @note Registered for completed runs and not called yet
+  std::vector<Continuation> mCalling; /// @note Spare storage for callContinuations()
+}; /// class RunTracker
+
+///
+/// @brief Completion handle of one run() or pipeline() call.
+/// @note A default-constructed handle refers to a run that has nothing to
+///   do, and is always complete. wait() takes part in the run the way the
+///   scheduler's own wait() does, so main-thread tasks still run on the
+///   waiting thread.
+///
+template <typename IMPL>
+class RunHandle
+{
+public:
+  RunHandle() : mImpl(NULL), mRun(0) {}
+  RunHandle(IMPL *impl, const uint64_t run) : mImpl(impl), mRun(run) {}
+  FORCE_INLINE uint64_t getRun() const { return this->mRun; }
+  FORCE_INLINE bool isComplete() const { return (!this->mImpl || this->mImpl->isComplete(this->mRun)); }
+
+  ///
+  /// @note Returns false if the run has not completed within timeout microseconds.
+  ///
+  FORCE_INLINE bool wait(const uint64_t timeout = RunTracker::INFINITE) const { return (!this->mImpl || this->mImpl->wait(this->mRun, timeout)); }
+
+  ///
+  /// @note Calls continuation at once if the run has already completed.
+  ///
+  FORCE_INLINE void then(const RunTracker::ContinuationType continuation, void *context) const
+  {
+    if (!this->mImpl)
+    {
+      continuation(context);
+      return;
+    }
+    this->mImpl->then(this->mRun, continuation, context);
+  }
+
+protected:
+  IMPL *mImpl;
+  uint64_t mRun;
+}; /// class RunHandle
+
+} /// namespace Concurrency
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_CORE_CONCURRENCY_RUNHANDLE_H
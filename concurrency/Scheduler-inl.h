@@ -17,20 +17,66 @@ Scheduler<TRAITS>::~Scheduler()
 template <typename TRAITS>
 bool Scheduler<TRAITS>::registerTask(const TaskType &task)
 {
-  typename TaskType::Pointer copy(new TaskType(task));
-  return this->mImpl.registerTask(copy);
+  typename TaskType::Pointer copy = this->mFactory.copy(task);
+  boost::mutex::scoped_lock lock(this->mCopyMutex);
+  if (!this->mImpl.registerTask(copy))
+  {
+    this->mFactory.release(copy);
+    return false;
+  }
+  this->mCopies.insert(std::lower_bound(this->mCopies.begin(), this->mCopies.end(), copy->getTaskId(), CopyCompare()), copy);
+  return true;
+}
+
+template <typename TRAITS>
+bool Scheduler<TRAITS>::registerTask(const typename TaskType::Pointer &task)
+{
+  return this->mImpl.registerTask(task);
 }
 
 template <typename TRAITS>
 bool Scheduler<TRAITS>::unregisterTask(const typename TaskType::IdType taskType)
 {
-  return this->mImpl.unregisterTask(taskType);
+  boost::mutex::scoped_lock lock(this->mCopyMutex);
+  if (!this->mImpl.unregisterTask(taskType)) { return false; }
+  this->release(taskType);
+  return true;
+}
+
+template <typename TRAITS>
+uint32_t Scheduler<TRAITS>::registerTasks(const TaskList &tasks)
+{
+  return this->mImpl.registerTasks(tasks);
+}
+
+template <typename TRAITS>
+uint32_t Scheduler<TRAITS>::unregisterTasks(const IdList &taskIds)
+{
+  boost::mutex::scoped_lock lock(this->mCopyMutex);
+  const uint32_t count = this->mImpl.unregisterTasks(taskIds);
+  typename IdList::const_iterator
+    iter = taskIds.begin(),
+    end = taskIds.end();
+  for (; iter != end; ++iter)
+  {
+    this->release(*iter);
+  }
+  return count;
 }
 
 template <typename TRAITS>
 void Scheduler<TRAITS>::clear()
 {
   this->mImpl.clear();
+  boost::mutex::scoped_lock lock(this->mCopyMutex);
+  typename CopyList::iterator
+    iter = this->mCopies.begin(),
+    end = this->mCopies.end();
+  for (; iter != end; ++iter)
+  {
+    this->mFactory.release(*iter);
+  }
+  this->mCopies.clear();
 }
 
 template <typename TRAITS>
@@ -40,7 +86,172 @@ void Scheduler<TRAITS>::schedule()
 }
 
 template <typename TRAITS>
-void Scheduler<TRAITS>::run(const bool wait)
+typename Scheduler<TRAITS>::HandleType Scheduler<TRAITS>::run(const bool wait)
+{
+  return this->mImpl.run(typename TaskType::InputType(), wait);
+}
+
+template <typename TRAITS>
+typename Scheduler<TRAITS>::HandleType Scheduler<TRAITS>::pipeline(const uint32_t frameCount, const bool wait)
+{
+  return this->mImpl.pipeline(frameCount, typename TaskType::InputType(), wait);
+}
+
+template <typename TRAITS>
+void Scheduler<TRAITS>::setFramesInFlight(const uint32_t framesInFlight)
+{
+  this->mImpl.setFramesInFlight(framesInFlight);
+}
+
+template <typename TRAITS>
+uint32_t Scheduler<TRAITS>::getFramesInFlight() const
+{
+  return this->mImpl.getFramesInFlight();
+}
+
+template <typename TRAITS>
+Tracer& Scheduler<TRAITS>::getTracer()
+{
+  return this->mImpl.getTracer();
+}
+
+template <typename TRAITS>
+FrameBudget& Scheduler<TRAITS>::getBudget()
+{
+  return this->mImpl.getBudget();
+}
+
+template <typename TRAITS>
+FrameArena& Scheduler<TRAITS>::getArena(const uint32_t slot)
+{
+  return this->mImpl.getArena(slot);
+}
+
+template <typename TRAITS>
+uint32_t Scheduler<TRAITS>::getWorkerCount() const
+{
+  return this->mImpl.getWorkerCount();
+}
+
+///
+/// @note Returns the registered copy of a task, if any, to the factory;
+///   the factory only hands it out again once the backend has dropped it.
+///   Called with mCopyMutex held.
+///
+template <typename TRAITS>
+void Scheduler<TRAITS>::release(const typename TaskType::IdType taskId)
+{
+  typename CopyList::iterator iter = std::lower_bound(this->mCopies.begin(), this->mCopies.end(), taskId, CopyCompare());
+  if ((iter == this->mCopies.end()) || ((*iter)->getTaskId() != taskId)) { return; }
+  this->mFactory.release(*iter);
+  this->mCopies.erase(iter);
+}
+
+///
+/// @note Calls body(chunkBegin, chunkEnd) over disjoint chunks covering
+///   [begin, end) on the scheduler's workers. Safe to call from inside a task.
+///
+template <typename TRAITS>
+template <typename BODY>
+void Scheduler<TRAITS>::parallelFor(const size_t begin, const size_t end, const BODY &body)
+{
+  this->mImpl.parallelFor(begin, end, body);
+}
+
+///
+/// @note body(chunkBegin, chunkEnd) returns the partial result of a chunk;
+///   partials are joined from left to right, so join must be associative
+///   but need not be commutative.
+///
+template <typename TRAITS>
+template <typename T, typename BODY, typename JOIN>
+T Scheduler<TRAITS>::parallelReduce(const size_t begin, const size_t end, const T &identity, const BODY &body, const JOIN &join)
+{
+  if (end <= begin) { return identity; }
+
+  /// Local vars
+  const size_t count = end - begin;
+  const size_t chunks = std::min<size_t>(count, std::max<uint32_t>(1, this->getWorkerCount()) * Scheduler<TRAITS>::REDUCE_CHUNKS_PER_WORKER);
+  std::vector<T> partials(chunks, identity);
+
+  this->parallelFor(0, chunks, ReduceBody<T, BODY>(begin, count, chunks, body, partials));
+
+  T result = identity;
+  for (size_t chunk = 0; chunk < chunks; ++chunk)
+  {
+    result = join(result, partials[chunk]);
+  }
+  return result;
+}
+
+///
+/// @note Sorts up to two runs per worker in parallel, then merges pairs of
+///   runs in parallel rounds. Not stable.
+///
+template <typename TRAITS>
+template <typename ITERATOR, typename COMPARE>
+void Scheduler<TRAITS>::parallelSort(ITERATOR first, ITERATOR last, const COMPARE &compare)
+{
+  /// Local vars
+  const size_t count = last - first;
+  const size_t workers = std::max<uint32_t>(1, this->getWorkerCount());
+  size_t chunks = 1;
+
+  /// Power-of-two number of runs, none shorter than SORT_CUTOFF
+  while ((chunks < workers * 2) && ((count / (chunks * 2)) >= Scheduler<TRAITS>::SORT_CUTOFF)) { chunks <<= 1; }
+  if (chunks == 1)
+  {
+    std::sort(first, last, compare);
+    return;
+  }
+
+  this->parallelFor(0, chunks, SortBody<ITERATOR, COMPARE>(first, count, chunks, 0, compare));
+  for (size_t width = 1; width < chunks; width <<= 1)
+  {
+    this->parallelFor(0, chunks / (width * 2), SortBody<ITERATOR, COMPARE>(first, count, chunks, width, compare));
+  }
+}
+
+template <typename TRAITS>
+template <typename ITERATOR>
+void Scheduler<TRAITS>::parallelSort(ITERATOR first, ITERATOR last)
+{
+  this->parallelSort(first, last, std::less<typename std::iterator_traits<ITERATOR>::value_type>());
+}
+
+///
+/// @class Scheduler<>::ReduceBody
+///
+
+template <typename TRAITS>
+template <typename T, typename BODY>
+void Scheduler<TRAITS>::ReduceBody<T, BODY>::operator()(const size_t first, const size_t last) const
 {
-  this->mImpl.run(typename TaskType::InputType(), wait);
+  for (size_t chunk = first; chunk < last; ++chunk)
+  {
+    this->mPartials[chunk] = this->mBody(
+      this->mBegin + (this->mCount * chunk) / this->mChunks,
+      this->mBegin + (this->mCount * (chunk + 1)) / this->mChunks);
+  }
+}
+
+///
+/// @class Scheduler<>::SortBody
+///
+
+template <typename TRAITS>
+template <typename ITERATOR, typename COMPARE>
+void Scheduler<TRAITS>::SortBody<ITERATOR, COMPARE>::operator()(const size_t first, const size_t last) const
+{
+  for (size_t index = first; index < last; ++index)
+  {
+    if (!this->mWidth)
+    {
+      std::sort(this->at(index), this->at(index + 1), this->mCompare);
+      continue;
+    }
+
+    const size_t chunk = index * this->mWidth * 2;
+    std::inplace_merge(this->at(chunk), this->at(chunk + this->mWidth), this->at(chunk + this->mWidth * 2), this->mCompare);
+  }
 }
@@ -35,29 +35,99 @@
 
 #include "System"
 #include "Pattern"
+#include "concurrency/FrameArena.h"
+#include "concurrency/FrameBudget.h"
 #include "concurrency/Task.h"
+#include "concurrency/TaskFactory.h"
+#include "concurrency/Trace.h"
 
 namespace RSSD {
 namespace Core {
 namespace Concurrency {
 
+///
+/// @brief Facade over a scheduler backend.
+/// @note Runs of one scheduler do not overlap; graphs that must run
+///   concurrently each get a Scheduler of their own. Concurrency::BasicScheduler
+///   is the process-wide instance.
+///
 template <typename IMPL>
-class Scheduler : public Pattern::Singleton<Scheduler<IMPL> >
+class Scheduler
 {
 public:
   typedef IMPL ImplType;
   typedef typename IMPL::TaskType TaskType;
+  typedef typename IMPL::TaskList TaskList;
+  typedef typename IMPL::IdList IdList;
+  typedef typename IMPL::HandleType HandleType;
+  typedef TaskFactory<TaskType> FactoryType;
 
   Scheduler();
   virtual ~Scheduler();
-  virtual bool registerTask(const TaskType &task);
+  virtual bool registerTask(const TaskType &task); /// @note Registers a copy taken from the task factory
+  virtual bool registerTask(const typename TaskType::Pointer &task); /// @note Registers the task itself rather than a copy
   virtual bool unregisterTask(const typename TaskType::IdType taskType);
+  virtual uint32_t registerTasks(const TaskList &tasks); /// @note Registers a whole subgraph with a single graph update
+  virtual uint32_t unregisterTasks(const IdList &taskIds);
   virtual void clear();
   virtual void schedule();
-  virtual void run(const bool wait = true);
+  virtual HandleType run(const bool wait = true);
+  virtual HandleType pipeline(const uint32_t frameCount, const bool wait = true);
+  virtual void setFramesInFlight(const uint32_t framesInFlight);
+  virtual uint32_t getFramesInFlight() const;
+  virtual Tracer& getTracer();
+  virtual FrameBudget& getBudget();
+  virtual FrameArena& getArena(const uint32_t slot = 0); /// @note Scratch memory for the tasks of the frame in a slot; run() uses slot 0
+  virtual uint32_t getWorkerCount() const;
+  FORCE_INLINE FactoryType& getFactory() { return this->mFactory; }
+  template <typename BODY> void parallelFor(const size_t begin, const size_t end, const BODY &body);
+  template <typename T, typename BODY, typename JOIN> T parallelReduce(const size_t begin, const size_t end, const T &identity, const BODY &body, const JOIN &join);
+  template <typename ITERATOR, typename COMPARE> void parallelSort(ITERATOR first, ITERATOR last, const COMPARE &compare);
+  template <typename ITERATOR> void parallelSort(ITERATOR first, ITERATOR last);
+
+  static const uint32_t REDUCE_CHUNKS_PER_WORKER = 4;
+  static const size_t SORT_CUTOFF = 2048; /// @note Smallest run sorted by one worker
 
 protected:
+  typedef std::vector<typename TaskType::Pointer> CopyList;
+
+  /// @note Copies by task ID
+  struct CopyCompare
+  {
+    bool operator()(const typename TaskType::Pointer &lhs, const typename TaskType::IdType rhs) const { return (lhs->getTaskId() < rhs); }
+  }; /// struct CopyCompare
+
+  void release(const typename TaskType::IdType taskId);
+
+  template <typename T, typename BODY>
+  struct ReduceBody
+  {
+    ReduceBody(const size_t begin, const size_t count, const size_t chunks, const BODY &body, std::vector<T> &partials) :
+      mBegin(begin), mCount(count), mChunks(chunks), mBody(body), mPartials(partials) {}
+    void operator()(const size_t first, const size_t last) const;
+
+    size_t mBegin, mCount, mChunks;
+    const BODY &mBody;
+    std::vector<T> &mPartials;
+  }; /// struct ReduceBody
+
+  template <typename ITERATOR, typename COMPARE>
+  struct SortBody
+  {
+    SortBody(ITERATOR begin, const size_t count, const size_t chunks, const size_t width, const COMPARE &compare) :
+      mBegin(begin), mCount(count), mChunks(chunks), mWidth(width), mCompare(compare) {}
+    FORCE_INLINE ITERATOR at(const size_t chunk) const { return this->mBegin + (this->mCount * std::min(chunk, this->mChunks)) / this->mChunks; }
+    void operator()(const size_t first, const size_t last) const;
+
+    ITERATOR mBegin;
+    size_t mCount, mChunks, mWidth; /// @note Width 0 sorts single chunks; otherwise merges pairs of sorted runs of that many chunks
+    const COMPARE &mCompare;
+  }; /// struct SortBody
+
   ImplType mImpl;
+  FactoryType mFactory;
+  CopyList mCopies; /// @note Registered copies, ascending by task ID; returned to the factory once unregistered
+  boost::mutex mCopyMutex;
 }; /// class Scheduler
 
 ///
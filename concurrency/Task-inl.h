@@ -9,23 +9,49 @@ BaseTask<TRAITS>::BaseTask(
   const IdType dependency,
   const TRAITS &traits) :
   mRecurring(recurring),
+  mSerial(true),
+  mMainThread(false),
   mPriority(priority),
   mTaskId(Task::generateTaskId<TRAITS>()),
   mTraits(traits),
-  mDependency(dependency)
+  mDuration(0),
+  mDeadline(0),
+  mInputSlots(1),
+  mOutputVersion(new Version())
 {
-  this->setFunctor(std::tr1::bind(&BaseTask<TRAITS>::operator(), *this, _1));
+  if (dependency) { this->mDependencies.push_back(dependency); }
+  this->setFunctor(Invoker(this));
 }
 
+///
+/// @note The copy shares the output version of the original, so tasks
+///   that declared the original's output as an input follow the runs of
+///   a copy registered in its place.
+///
 template <typename TRAITS>
 BaseTask<TRAITS>::BaseTask(const BaseTask<TRAITS> &rhs)
+{
+  *this = rhs;
+}
+
+template <typename TRAITS>
+BaseTask<TRAITS>& BaseTask<TRAITS>::operator=(const BaseTask<TRAITS> &rhs)
 {
   this->mRecurring = rhs.mRecurring;
+  this->mSerial = rhs.mSerial;
+  this->mMainThread = rhs.mMainThread;
   this->mPriority = rhs.mPriority;
   this->mTaskId = rhs.mTaskId;
   this->mTraits = rhs.mTraits;
-  this->mDependency = rhs.mDependency;
-  this->setFunctor(boost::bind(&BaseTask<TRAITS>::operator(), this, _1));
+  this->mDependencies = rhs.mDependencies;
+  this->mDuration = rhs.mDuration;
+  this->mDeadline = rhs.mDeadline;
+  this->mInputs = rhs.mInputs;
+  this->mInputVersions = rhs.mInputVersions;
+  this->mInputSlots = rhs.mInputSlots;
+  this->mOutputVersion = rhs.mOutputVersion;
+  this->setFunctor(Invoker(this));
+  return *this;
 }
 
 template <typename TRAITS>
@@ -40,3 +66,136 @@ typename BaseTask<TRAITS>::OutputType BaseTask<TRAITS>::operator()(typename Base
   this->run();
   // return this->mOutput;
 }
+
+template <typename TRAITS>
+bool BaseTask<TRAITS>::hasDependency(const IdType taskId) const
+{
+  return (std::find(this->mDependencies.begin(), this->mDependencies.end(), taskId) != this->mDependencies.end());
+}
+
+template <typename TRAITS>
+bool BaseTask<TRAITS>::addDependency(const IdType taskId)
+{
+  if (!taskId || (taskId == this->mTaskId) || this->hasDependency(taskId)) { return false; }
+  this->mDependencies.push_back(taskId);
+  return true;
+}
+
+template <typename TRAITS>
+bool BaseTask<TRAITS>::removeDependency(const IdType taskId)
+{
+  typename DependencyList::iterator iter = std::find(this->mDependencies.begin(), this->mDependencies.end(), taskId);
+  if (iter == this->mDependencies.end()) { return false; }
+  this->mDependencies.erase(iter);
+  return true;
+}
+
+///
+/// @note The version must outlive the task, or be removed first.
+///
+template <typename TRAITS>
+bool BaseTask<TRAITS>::addInput(const Version &version)
+{
+  if (std::find(this->mInputs.begin(), this->mInputs.end(), &version) != this->mInputs.end()) { return false; }
+  this->mInputs.push_back(&version);
+  this->mInputVersions.assign(this->mInputs.size() * this->mInputSlots, 0);
+  return true;
+}
+
+template <typename TRAITS>
+bool BaseTask<TRAITS>::removeInput(const Version &version)
+{
+  typename InputList::iterator iter = std::find(this->mInputs.begin(), this->mInputs.end(), &version);
+  if (iter == this->mInputs.end()) { return false; }
+  this->mInputs.erase(iter);
+  this->mInputVersions.assign(this->mInputs.size() * this->mInputSlots, 0);
+  return true;
+}
+
+///
+/// @note True if the task declares inputs and none of them has changed
+///   since its last run in this frame slot; the output it left in the
+///   slot is then still valid.
+///
+template <typename TRAITS>
+bool BaseTask<TRAITS>::isUpToDate(const uint32_t slot) const
+{
+  if (this->mInputs.empty()) { return false; }
+  assert(slot < this->mInputSlots);
+  const uint64_t *seen = &this->mInputVersions[slot * this->mInputs.size()];
+  for (size_t index = 0; index < this->mInputs.size(); ++index)
+  {
+    if (this->mInputs[index]->get() != seen[index]) { return false; }
+  }
+  return true;
+}
+
+///
+/// @note Called as the task starts, so that a change made while it runs
+///   makes it run again.
+///
+template <typename TRAITS>
+void BaseTask<TRAITS>::captureInputs(const uint32_t slot)
+{
+  if (this->mInputs.empty()) { return; }
+  assert(slot < this->mInputSlots);
+  uint64_t *seen = &this->mInputVersions[slot * this->mInputs.size()];
+  for (size_t index = 0; index < this->mInputs.size(); ++index)
+  {
+    seen[index] = this->mInputs[index]->get();
+  }
+}
+
+///
+/// @note Frames in flight keep their outputs in separate Port slots, so a
+///   task is only up to date in a slot if it has run there. Changing the
+///   slot count forgets every seen version. Must only be called while the
+///   task is not running.
+///
+template <typename TRAITS>
+void BaseTask<TRAITS>::setInputSlots(const uint32_t slotCount)
+{
+  if (slotCount == this->mInputSlots) { return; }
+  this->mInputSlots = std::max<uint32_t>(1, slotCount);
+  this->mInputVersions.assign(this->mInputs.size() * this->mInputSlots, 0);
+}
+
+///
+/// @note Exponential moving average (weight 1/4) so that one slow frame
+///   does not reorder the whole graph.
+///
+template <typename TRAITS>
+void BaseTask<TRAITS>::sampleDuration(const uint64_t microseconds)
+{
+  this->mDuration = this->mDuration ? ((this->mDuration * 3 + microseconds) / 4) : microseconds;
+}
+
+///
+/// @note Reinitialises a recycled task as if newly constructed. The
+///   dependency list keeps its capacity so that reuse does not allocate.
+///
+template <typename TRAITS>
+void BaseTask<TRAITS>::reset(
+  const bool recurring,
+  const uint32_t priority,
+  const IdType dependency)
+{
+  this->mRecurring = recurring;
+  this->mSerial = true;
+  this->mMainThread = false;
+  this->mPriority = priority;
+  this->mTaskId = Task::generateTaskId<TRAITS>();
+  this->mDependencies.clear();
+  if (dependency) { this->mDependencies.push_back(dependency); }
+  this->mDuration = 0;
+  this->mDeadline = 0;
+  this->mInputs.clear();
+  this->mInputVersions.clear();
+  this->mInputSlots = 1;
+  this->setFunctor(Invoker(this));
+
+  /// A copy of the previous task may still be registered and keeps the old
+  /// version; the version is only reused once nothing else shares it
+  if (this->mOutputVersion.unique()) { this->mOutputVersion->increment(); }
+  else { this->mOutputVersion.reset(new Version()); }
+}
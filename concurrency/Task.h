@@ -35,6 +35,8 @@
 
 #include "System"
 #include "Pattern"
+#include "concurrency/InlineFunctor.h"
+#include "concurrency/Version.h"
 
 namespace RSSD {
 namespace Core {
@@ -75,7 +77,9 @@ public:
   typedef typename TRAITS::IdType IdType;
   typedef typename TRAITS::InputType InputType;
   typedef typename TRAITS::OutputType OutputType;
-  typedef std::tr1::function<OutputType(InputType)> FunctorType;
+  typedef InlineFunctor<OutputType, InputType> FunctorType; /// @note Small callables are stored without allocating
+  typedef std::vector<IdType> DependencyList;
+  typedef std::vector<const Version*> InputList;
 
   struct Traits
   {
@@ -91,24 +95,64 @@ public:
     const IdType dependency = 0,
     const TRAITS &traits = TRAITS());
   BaseTask(const BaseTask<TRAITS> &rhs);
+  BaseTask<TRAITS>& operator=(const BaseTask<TRAITS> &rhs);
   virtual ~BaseTask();
   DEFINE_PROPERTY_INLINE(bool, Recurring, mRecurring);
+  DEFINE_PROPERTY_INLINE(bool, Serial, mSerial); /// @note Pipelined runs execute the frames of a serial task one at a time, in order
+  DEFINE_PROPERTY_INLINE(bool, MainThread, mMainThread); /// @note Runs only on the thread waiting for the graph in run() or wait()
   DEFINE_PROPERTY_INLINE(IdType, Priority, mPriority);
   DEFINE_PROPERTY_INLINE(IdType, TaskId, mTaskId);
-  DEFINE_PROPERTY_INLINE(IdType, Dependency, mDependency);
+  DEFINE_PROPERTY_INLINE(DependencyList, Dependencies, mDependencies);
+  DEFINE_PROPERTY_INLINE(uint64_t, Duration, mDuration); /// @note Smoothed execution time in microseconds
+  DEFINE_PROPERTY_INLINE(uint64_t, Deadline, mDeadline); /// @note Microseconds from the start of the frame; zero for none
   DEFINE_PROPERTY_INLINE(FunctorType, Functor, mFunctor);
   FORCE_INLINE OutputType operator()(InputType value);
+  bool hasDependency(const IdType taskId) const;
+  bool addDependency(const IdType taskId);
+  bool removeDependency(const IdType taskId);
+  bool addInput(const Version &version);
+  bool removeInput(const Version &version);
+  FORCE_INLINE const InputList& getInputs() const { return this->mInputs; }
+  FORCE_INLINE const Version& getOutputVersion() const { return *this->mOutputVersion; }
+  FORCE_INLINE bool isOutputShared() const { return !this->mOutputVersion.unique(); } /// @note True while a copy of this task shares its output version
+  FORCE_INLINE void swapOutputVersion(SharedPointer<Version> &version) { this->mOutputVersion.swap(version); } /// @note Lets a TaskPool recycle versions
+  bool isUpToDate(const uint32_t slot = 0) const;
+  void captureInputs(const uint32_t slot = 0);
+  void setInputSlots(const uint32_t slotCount); /// @note One set of seen input versions per frame slot
+  FORCE_INLINE void publishOutput() { this->mOutputVersion->increment(); }
+  void sampleDuration(const uint64_t microseconds);
+  void reset(
+    const bool recurring = false,
+    const uint32_t priority = Task::Priority::MEDIUM,
+    const IdType dependency = 0);
 
   /// @hack REMOVE THIS!
   virtual void run() {}
   virtual uint32_t getType() const { return 0; }
 
 protected:
+  /// @note Default functor; forwards to operator() without the allocation of a bind expression
+  struct Invoker
+  {
+    Invoker(BaseTask<TRAITS> *task) : mTask(task) {}
+    FORCE_INLINE OutputType operator()(InputType value) const { return (*this->mTask)(value); }
+
+    BaseTask<TRAITS> *mTask;
+  }; /// struct Invoker
+
   bool mRecurring;
+  bool mSerial;
+  bool mMainThread;
   IdType mPriority;
   IdType mTaskId;
   TRAITS mTraits;
-  IdType mDependency;
+  DependencyList mDependencies; /// @note The task runs once all of these have completed
+  uint64_t mDuration;
+  uint64_t mDeadline;
+  InputList mInputs; /// @note Versions this task's result depends on; none means it always runs
+  std::vector<uint64_t> mInputVersions; /// @note [Slot * inputs + input] => Version seen by the last run in that frame slot
+  uint32_t mInputSlots;
+  SharedPointer<Version> mOutputVersion; /// @note Incremented whenever the task has run; shared with copies, so dependents see a registered copy's runs
   FunctorType mFunctor;
 }; /// class BaseTask
 
@@ -124,17 +168,23 @@ protected:
 
 namespace std {
 
-template <>
 template <typename TRAITS>
 struct less<RSSD::Core::Concurrency::BaseTask<TRAITS> >
 {
+  bool operator() (
+    const RSSD::Core::Concurrency::BaseTask<TRAITS> &x,
+    const RSSD::Core::Concurrency::BaseTask<TRAITS> &y) const
+  {
+    if (x.getPriority() == y.getPriority())
+      return (x.getTaskId() > y.getTaskId());
+    return (x.getPriority() < y.getPriority());
+  }
+
   bool operator() (
     const typename RSSD::Core::Concurrency::BaseTask<TRAITS>::Pointer &x,
     const typename RSSD::Core::Concurrency::BaseTask<TRAITS>::Pointer &y) const
   {
-    if (x->getPriority() == y->getPriority())
-      return (x->getTaskID() < y->getTaskId());
-    return (x->getPriority() < y->getPriority());
+    return this->operator()(*x, *y);
   }
 }; /// struct less
 
@@ -0,0 +1,34 @@
+///
+/// @class TaskFactory
+///
+
+template <typename TASK>
+uint32_t TaskFactory<TASK>::TYPE = ++Task::Factory::TYPEID;
+
+template <typename TASK>
+TaskFactory<TASK>::TaskFactory()
+{
+  /// Register factory on creation
+  Task::Manager *manager = Task::Manager::getPointer();
+  if (manager) { manager->registerFactory(this); }
+}
+
+template <typename TASK>
+TaskFactory<TASK>::~TaskFactory()
+{
+  /// Unregister factory on destruction, unless another factory of this type holds the registration
+  Task::Manager *manager = Task::Manager::getPointer();
+  if (manager && (manager->getFactory(this->getType()) == this)) { manager->unregisterFactory(this->getType()); }
+}
+
+template <typename TASK>
+Task* TaskFactory<TASK>::create(params_t &params)
+{
+  return new TASK();
+}
+
+template <typename TASK>
+void TaskFactory<TASK>::destroy(Task *value)
+{
+  delete value;
+}
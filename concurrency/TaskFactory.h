@@ -0,0 +1,91 @@
+///
+/// @file TaskFactory.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by The Secret Design Collective
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+///     this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+///     this list of conditions and the following disclaimer in the documentation
+///     and/or other materials provided with the distribution.
+///    * Neither the name of The Secret Design Collective nor the names of its
+///     contributors may be used to endorse or promote products derived from
+///     this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+
+#ifndef RSSD_CORE_CONCURRENCY_TASKFACTORY_H
+#define RSSD_CORE_CONCURRENCY_TASKFACTORY_H
+
+#include "System"
+#include "Pattern"
+#include "concurrency/Task.h"
+#include "concurrency/TaskPool.h"
+
+namespace RSSD {
+namespace Core {
+namespace Concurrency {
+
+///
+/// @brief Task::Factory for one task type, backed by a TaskPool.
+/// @note create() and destroy() serve the Task::Manager interface with raw
+///   tasks; acquire(), copy() and release() hand out pooled shared tasks
+///   without allocating in steady state. The factory registers itself with
+///   the Task::Manager, if one exists, for as long as it lives.
+///
+template <typename TASK>
+class TaskFactory : public Task::Factory
+{
+public:
+  typedef TASK TaskType;
+  typedef typename TASK::Pointer Pointer;
+  typedef typename TASK::IdType IdType;
+  typedef TaskPool<TASK> Pool;
+
+  TaskFactory();
+  virtual ~TaskFactory();
+  virtual const uint32_t getType() const { return TaskFactory<TASK>::TYPE; }
+  virtual Task* create(params_t &params = params_t());
+  virtual void destroy(Task *value);
+  FORCE_INLINE Pointer acquire(
+    const bool recurring = false,
+    const uint32_t priority = Task::Priority::MEDIUM,
+    const IdType dependency = 0) { return this->mPool.acquire(recurring, priority, dependency); }
+  FORCE_INLINE Pointer copy(const TASK &task) { return this->mPool.copy(task); }
+  FORCE_INLINE void release(const Pointer &task) { this->mPool.release(task); }
+  FORCE_INLINE Pool& getPool() { return this->mPool; }
+
+  static uint32_t TYPE;
+
+protected:
+  Pool mPool;
+}; /// class TaskFactory
+
+///
+/// Includes
+///
+
+#include "concurrency/TaskFactory-inl.h"
+
+} /// namespace Concurrency
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_CORE_CONCURRENCY_TASKFACTORY_H
@@ -0,0 +1,109 @@
+///
+/// @class TaskPool
+///
+
+template <typename TASK>
+typename TaskPool<TASK>::Pointer TaskPool<TASK>::acquire(
+  const bool recurring,
+  const uint32_t priority,
+  const IdType dependency)
+{
+  Pointer task = this->take();
+  if (!task) { return Pointer(new TASK(recurring, priority, dependency)); }
+
+  /// A copy of the task's previous life keeps the shared version
+  if (task->isOutputShared())
+  {
+    boost::mutex::scoped_lock lock(this->mMutex);
+    if (!this->mVersions.empty())
+    {
+      task->swapOutputVersion(this->mVersions.back());
+      this->mVersions.pop_back();
+    }
+  }
+  task->reset(recurring, priority, dependency);
+  return task;
+}
+
+///
+/// @note Returns a pooled copy of the task, as made by its copy constructor.
+///
+template <typename TASK>
+typename TaskPool<TASK>::Pointer TaskPool<TASK>::copy(const TASK &task)
+{
+  /// Local vars
+  SharedPointer<Version> version;
+
+  Pointer result = this->take();
+  if (!result) { return Pointer(new TASK(task)); }
+  result->swapOutputVersion(version);
+  *result = task;
+  if (!version.unique()) { return result; }
+
+  /// Keep at most one spare version per pooled task
+  boost::mutex::scoped_lock lock(this->mMutex);
+  if (this->mVersions.size() < this->mTasks.size()) { this->mVersions.push_back(version); }
+  return result;
+}
+
+///
+/// @note The caller should not hold on to other references to the task.
+///
+template <typename TASK>
+void TaskPool<TASK>::release(const Pointer &task)
+{
+  if (!task) { return; }
+  boost::mutex::scoped_lock lock(this->mMutex);
+  this->mTasks.push_back(task);
+}
+
+template <typename TASK>
+void TaskPool<TASK>::reserve(const size_t count)
+{
+  boost::mutex::scoped_lock lock(this->mMutex);
+  this->mTasks.reserve(count);
+  while (this->mTasks.size() < count)
+  {
+    this->mTasks.push_back(Pointer(new TASK()));
+  }
+}
+
+template <typename TASK>
+size_t TaskPool<TASK>::getSize() const
+{
+  boost::mutex::scoped_lock lock(this->mMutex);
+  return this->mTasks.size();
+}
+
+template <typename TASK>
+void TaskPool<TASK>::clear()
+{
+  boost::mutex::scoped_lock lock(this->mMutex);
+  this->mTasks.clear();
+  this->mVersions.clear();
+}
+
+///
+/// @note Returns the most recently released task that nothing else still
+///   references, or an empty pointer if there is none.
+///
+template <typename TASK>
+typename TaskPool<TASK>::Pointer TaskPool<TASK>::take()
+{
+  /// Local vars
+  Pointer task;
+
+  boost::mutex::scoped_lock lock(this->mMutex);
+  typename std::vector<Pointer>::reverse_iterator
+    iter = this->mTasks.rbegin(),
+    end = this->mTasks.rend();
+  for (; iter != end; ++iter)
+  {
+    if (!iter->unique()) { continue; }
+    task.swap(*iter);
+    std::swap(*iter, this->mTasks.back());
+    this->mTasks.pop_back();
+    break;
+  }
+  return task;
+}
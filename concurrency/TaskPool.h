@@ -0,0 +1,92 @@
+///
+/// @file TaskPool.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by The Secret Design Collective
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+///     this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+///     this list of conditions and the following disclaimer in the documentation
+///     and/or other materials provided with the distribution.
+///    * Neither the name of The Secret Design Collective nor the names of its
+///     contributors may be used to endorse or promote products derived from
+///     this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+
+#ifndef RSSD_CORE_CONCURRENCY_TASKPOOL_H
+#define RSSD_CORE_CONCURRENCY_TASKPOOL_H
+
+#include "System"
+#include "concurrency/Version.h"
+
+namespace RSSD {
+namespace Core {
+namespace Concurrency {
+
+///
+/// @brief Free list of tasks for workloads that create and destroy tasks
+///   at a high rate.
+/// @note The pool keeps the shared pointers themselves, so a recycled task
+///   reuses both its object and its reference count block. A released task
+///   is only handed out again once the pool holds its last reference, so a
+///   task may be released before a scheduler has dropped it. Output
+///   versions that copy() replaces are kept for acquire(), which gives them
+///   to recycled tasks whose version is still shared with a copy. Once the
+///   pool has been warmed up (see reserve()), acquire(), copy() and
+///   release() do not allocate.
+///
+template <typename TASK>
+class TaskPool : boost::noncopyable
+{
+public:
+  typedef typename TASK::Pointer Pointer;
+  typedef typename TASK::IdType IdType;
+
+  TaskPool() {}
+  Pointer acquire(
+    const bool recurring = false,
+    const uint32_t priority = TASK::Priority::MEDIUM,
+    const IdType dependency = 0);
+  Pointer copy(const TASK &task);
+  void release(const Pointer &task);
+  void reserve(const size_t count);
+  size_t getSize() const;
+  void clear();
+
+protected:
+  Pointer take();
+
+  std::vector<Pointer> mTasks;
+  std::vector<SharedPointer<Version> > mVersions; /// @note Unshared output versions replaced by copy()
+  mutable boost::mutex mMutex;
+}; /// class TaskPool
+
+///
+/// Includes
+///
+
+#include "concurrency/TaskPool-inl.h"
+
+} /// namespace Concurrency
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_CORE_CONCURRENCY_TASKPOOL_H
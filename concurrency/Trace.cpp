@@ -0,0 +1,167 @@
+#include <fstream>
+#include <set>
+#include "concurrency/Trace.h"
+
+using namespace RSSD;
+using namespace RSSD::Core;
+using namespace RSSD::Core::Concurrency;
+
+///
+/// @class Tracer::Buffer
+///
+
+Tracer::Buffer::Buffer(const uint32_t capacity) :
+  mOwner(boost::this_thread::get_id()),
+  mMask(capacity - 1),
+  mCount(0),
+  mEvents(new Event[capacity])
+{
+
+}
+
+///
+/// @class Tracer
+///
+
+std::atomic<uint32_t> Tracer::COUNTER(1);
+THREAD_LOCAL uint32_t Tracer::CURRENT_TRACER = 0;
+THREAD_LOCAL Tracer::Buffer *Tracer::CURRENT_BUFFER = NULL;
+
+Tracer::Tracer(const uint32_t capacity) :
+  mIsEnabled(true),
+  mId(Tracer::COUNTER.fetch_add(1)),
+  mCapacity(1),
+  mEpoch(Tracer::clock())
+{
+  /// Round capacity up to a power of two so that wrapping is a mask
+  while (this->mCapacity < capacity) { this->mCapacity <<= 1; }
+}
+
+Tracer::~Tracer()
+{
+  std::vector<Buffer*>::iterator
+    iter = this->mBuffers.begin(),
+    end = this->mBuffers.end();
+  for (; iter != end; ++iter)
+  {
+    delete *iter;
+  }
+}
+
+void Tracer::record(const uint64_t start, const uint64_t end, const uint32_t taskId, const uint32_t priority, const uint64_t frame, const uint32_t worker)
+{
+  Buffer *buffer = this->getBuffer();
+  const uint64_t count = buffer->mCount.load(std::memory_order_relaxed);
+  Event &event = buffer->mEvents[count & buffer->mMask];
+  event.mStart = start;
+  event.mEnd = end;
+  event.mFrame = frame;
+  event.mTaskId = taskId;
+  event.mPriority = priority;
+  event.mWorker = worker;
+  buffer->mCount.store(count + 1, std::memory_order_release);
+}
+
+void Tracer::clear()
+{
+  boost::mutex::scoped_lock lock(this->mBufferMutex);
+  std::vector<Buffer*>::iterator
+    iter = this->mBuffers.begin(),
+    end = this->mBuffers.end();
+  for (; iter != end; ++iter)
+  {
+    (*iter)->mCount.store(0, std::memory_order_relaxed);
+  }
+  this->mEpoch = Tracer::clock();
+}
+
+void Tracer::write(std::ostream &stream) const
+{
+  /// Local vars
+  boost::mutex::scoped_lock lock(this->mBufferMutex);
+  std::set<uint32_t> workers;
+  const char *separator = "";
+  const std::ios_base::fmtflags flags = stream.flags();
+  const std::streamsize precision = stream.precision();
+
+  stream << std::fixed;
+  stream.precision(3);
+  stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  std::vector<Buffer*>::const_iterator
+    iter = this->mBuffers.begin(),
+    end = this->mBuffers.end();
+  for (; iter != end; ++iter)
+  {
+    const Buffer *buffer = *iter;
+    const uint64_t count = buffer->mCount.load(std::memory_order_acquire);
+    const uint64_t first = (count > buffer->mMask) ? (count - buffer->mMask - 1) : 0;
+
+    /// One complete ("X") event per task execution; timestamps in microseconds
+    for (uint64_t index = first; index < count; ++index)
+    {
+      const Event &event = buffer->mEvents[index & buffer->mMask];
+      workers.insert(event.mWorker);
+      stream << separator << "{\"name\":\"Task " << event.mTaskId
+        << "\",\"cat\":\"task\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.mWorker
+        << ",\"ts\":" << (event.mStart / 1000.0)
+        << ",\"dur\":" << ((event.mEnd - event.mStart) / 1000.0)
+        << ",\"args\":{\"task\":" << event.mTaskId
+        << ",\"priority\":" << event.mPriority
+        << ",\"frame\":" << event.mFrame << "}}";
+      separator = ",";
+    }
+  }
+
+  /// Name one row per worker
+  std::set<uint32_t>::const_iterator
+    worker = workers.begin(),
+    last = workers.end();
+  for (; worker != last; ++worker)
+  {
+    stream << separator
+      << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << *worker
+      << ",\"args\":{\"name\":\"Worker " << *worker << "\"}}";
+    separator = ",";
+  }
+  stream << "]}\n";
+
+  stream.flags(flags);
+  stream.precision(precision);
+}
+
+bool Tracer::save(const string_t &path) const
+{
+  std::ofstream stream(path.c_str());
+  if (!stream) { return false; }
+  this->write(stream);
+  return stream.good();
+}
+
+Tracer::Buffer* Tracer::getBuffer()
+{
+  if (Tracer::CURRENT_TRACER == this->mId) { return Tracer::CURRENT_BUFFER; }
+
+  /// Reuse this thread's buffer if it has recorded into this tracer before
+  boost::mutex::scoped_lock lock(this->mBufferMutex);
+  const boost::thread::id owner = boost::this_thread::get_id();
+  Buffer *buffer = NULL;
+  std::vector<Buffer*>::iterator
+    iter = this->mBuffers.begin(),
+    end = this->mBuffers.end();
+  for (; iter != end; ++iter)
+  {
+    if ((*iter)->mOwner == owner)
+    {
+      buffer = *iter;
+      break;
+    }
+  }
+  if (!buffer)
+  {
+    buffer = new Buffer(this->mCapacity);
+    this->mBuffers.push_back(buffer);
+  }
+  Tracer::CURRENT_TRACER = this->mId;
+  Tracer::CURRENT_BUFFER = buffer;
+  return buffer;
+}
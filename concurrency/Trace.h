@@ -0,0 +1,153 @@
+///
+/// @file Trace.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by The Secret Design Collective
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+///     this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+///     this list of conditions and the following disclaimer in the documentation
+///     and/or other materials provided with the distribution.
+///    * Neither the name of The Secret Design Collective nor the names of its
+///     contributors may be used to endorse or promote products derived from
+///     this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+
+#ifndef RSSD_CORE_CONCURRENCY_TRACE_H
+#define RSSD_CORE_CONCURRENCY_TRACE_H
+
+#include <ostream>
+#include "System"
+#include "Utilities"
+
+namespace RSSD {
+namespace Core {
+namespace Concurrency {
+
+///
+/// @brief Records one event per task execution into per-thread ring buffers
+///   and exports them as Chrome Trace Event JSON (chrome://tracing, Perfetto).
+/// @note Recording is wait-free: each thread only writes its own buffer and
+///   takes a lock once, the first time it records into a given tracer. When
+///   a buffer is full the oldest events are overwritten.
+/// @note Export and clear() must only be called while no run is in flight.
+/// @note Scheduler backends only record when built with RSSD_TRACE_SCHEDULER.
+///   Each event is reported on the row of the worker that ran it; a thread
+///   outside the pool that helps run tasks gets a row of its own.
+///
+class Tracer : public boost::noncopyable
+{
+public:
+  struct Event
+  {
+    uint64_t mStart; /// @note Nanoseconds since the tracer was created
+    uint64_t mEnd;
+    uint64_t mFrame;
+    uint32_t mTaskId;
+    uint32_t mPriority;
+    uint32_t mWorker; /// @note Reported as the Chrome trace thread id
+  }; /// struct Event
+
+  struct Buffer
+  {
+    Buffer(const uint32_t capacity);
+
+    boost::thread::id mOwner;
+    uint64_t mMask;
+    std::atomic<uint64_t> mCount; /// @note Events recorded so far; the newest capacity of them are kept
+    boost::scoped_array<Event> mEvents;
+  }; /// struct Buffer
+
+  Tracer(const uint32_t capacity = DEFAULT_CAPACITY);
+  ~Tracer();
+  DEFINE_PROPERTY_INLINE_VOLATILE(bool, IsEnabled, mIsEnabled);
+  FORCE_INLINE uint64_t now() const { return Tracer::clock() - this->mEpoch; }
+  void record(const uint64_t start, const uint64_t end, const uint32_t taskId, const uint32_t priority, const uint64_t frame, const uint32_t worker);
+  void clear();
+  void write(std::ostream &stream) const;
+  bool save(const string_t &path) const;
+
+  static const uint32_t DEFAULT_CAPACITY = 1 << 16; /// @note Events per thread
+
+protected:
+  Buffer* getBuffer();
+  static FORCE_INLINE uint64_t clock() { return Utilities::BasicTimer::now(); }
+
+  static std::atomic<uint32_t> COUNTER;
+  static THREAD_LOCAL uint32_t CURRENT_TRACER;
+  static THREAD_LOCAL Buffer *CURRENT_BUFFER;
+
+  volatile bool mIsEnabled;
+  uint32_t mId; /// @note Never reused, so a thread's cached buffer cannot outlive its tracer
+  uint32_t mCapacity;
+  uint64_t mEpoch;
+  std::vector<Buffer*> mBuffers;
+  mutable boost::mutex mBufferMutex;
+}; /// class Tracer
+
+///
+/// @brief Records the enclosing scope as one task execution.
+///
+class TraceScope : public boost::noncopyable
+{
+public:
+  FORCE_INLINE TraceScope(Tracer &tracer, const uint32_t taskId, const uint32_t priority, const uint64_t frame, const uint32_t worker) :
+    mTracer(tracer),
+    mIsEnabled(tracer.getIsEnabled()),
+    mStart(mIsEnabled ? tracer.now() : 0),
+    mFrame(frame),
+    mTaskId(taskId),
+    mPriority(priority),
+    mWorker(worker)
+  {
+  }
+
+  FORCE_INLINE ~TraceScope()
+  {
+    if (this->mIsEnabled) { this->mTracer.record(this->mStart, this->mTracer.now(), this->mTaskId, this->mPriority, this->mFrame, this->mWorker); }
+  }
+
+protected:
+  Tracer &mTracer;
+  bool mIsEnabled;
+  uint64_t mStart;
+  uint64_t mFrame;
+  uint32_t mTaskId;
+  uint32_t mPriority;
+  uint32_t mWorker;
+}; /// class TraceScope
+
+} /// namespace Concurrency
+} /// namespace Core
+} /// namespace RSSD
+
+///
+/// Macros
+///
+
+#if RSSD_TRACE_SCHEDULER
+#define RSSD_TRACE_TASK(TRACER, TASK, FRAME, WORKER) \
+  RSSD::Core::Concurrency::TraceScope traceScope((TRACER), (TASK).getTaskId(), (TASK).getPriority(), (FRAME), (WORKER))
+#else
+#define RSSD_TRACE_TASK(TRACER, TASK, FRAME, WORKER)
+#endif
+
+#endif /// RSSD_CORE_CONCURRENCY_TRACE_H
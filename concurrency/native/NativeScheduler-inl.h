@@ -0,0 +1,30 @@
+///
+/// @class NativeScheduler
+///
+
+template <typename BODY>
+std::atomic<uint64_t> NativeScheduler::LoopCost<BODY>::VALUE(0);
+
+///
+/// @note Calls body(chunkBegin, chunkEnd) over disjoint chunks covering
+///   [begin, end). The calling thread runs chunks and other ready work
+///   until the loop completes, so calls may nest inside tasks.
+///
+template <typename BODY>
+void NativeScheduler::parallelFor(const size_t begin, const size_t end, const BODY &body)
+{
+  if (end <= begin) { return; }
+
+  Loop loop;
+  loop.mBody = &body;
+  loop.mInvoke = &NativeScheduler::invoke<BODY>;
+  loop.mArena = FrameArena::getCurrent();
+  loop.mCost = &NativeScheduler::LoopCost<BODY>::VALUE;
+  this->runLoop(loop, begin, end);
+}
+
+template <typename BODY>
+void NativeScheduler::invoke(const void *body, const size_t begin, const size_t end)
+{
+  (*static_cast<const BODY*>(body))(begin, end);
+}
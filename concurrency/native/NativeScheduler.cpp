@@ -0,0 +1,1131 @@
+#include "concurrency/native/NativeScheduler.h"
+
+using namespace RSSD;
+using namespace RSSD::Core;
+using namespace RSSD::Core::Concurrency;
+using namespace RSSD::Core::Concurrency::Impl;
+
+///
+/// @class NativeScheduler
+///
+
+THREAD_LOCAL NativeScheduler::Worker *NativeScheduler::CURRENT_WORKER = NULL;
+THREAD_LOCAL NativeScheduler::LoopStorage *NativeScheduler::EXTERNAL_LOOPS = NULL;
+
+namespace {
+
+/// @note Tasks by ID
+struct TaskCompare
+{
+  bool operator()(const NativeScheduler::TaskType::Pointer &lhs, const NativeScheduler::TaskType::IdType rhs) const { return (lhs->getTaskId() < rhs); }
+  bool operator()(const NativeScheduler::TaskType::Pointer &lhs, const NativeScheduler::TaskType::Pointer &rhs) const { return (lhs->getTaskId() < rhs->getTaskId()); }
+}; /// struct TaskCompare
+
+/// @note Matches tasks whose IDs are in an ascending ID list
+struct TaskListed
+{
+  TaskListed(const NativeScheduler::IdList &taskIds) : mTaskIds(taskIds) {}
+  bool operator()(const NativeScheduler::TaskType::Pointer &task) const { return std::binary_search(this->mTaskIds.begin(), this->mTaskIds.end(), task->getTaskId()); }
+
+  const NativeScheduler::IdList &mTaskIds;
+}; /// struct TaskListed
+
+/// @note Roots by priority, then longest path first; ties keep node order
+struct RootCompare
+{
+  RootCompare(const NativeScheduler::Node *nodes) : mNodes(nodes) {}
+  bool operator()(const uint32_t lhs, const uint32_t rhs) const
+  {
+    const NativeScheduler::Node &x = this->mNodes[lhs], &y = this->mNodes[rhs];
+    if (x.mPriority != y.mPriority) { return (x.mPriority > y.mPriority); }
+    if (x.mCriticalPath != y.mCriticalPath) { return (x.mCriticalPath > y.mCriticalPath); }
+    return (lhs < rhs);
+  }
+
+  const NativeScheduler::Node *mNodes;
+}; /// struct RootCompare
+
+/// @note Successors are pushed in this order, so the longest path is popped first
+struct SuccessorCompare
+{
+  SuccessorCompare(const NativeScheduler::Node *nodes) : mNodes(nodes) {}
+  bool operator()(const uint32_t lhs, const uint32_t rhs) const { return (this->mNodes[lhs].mCriticalPath < this->mNodes[rhs].mCriticalPath); }
+
+  const NativeScheduler::Node *mNodes;
+}; /// struct SuccessorCompare
+
+} /// namespace
+
+NativeScheduler::NativeScheduler(const uint32_t workerCount, const uint32_t affinity) :
+  mIsGraphDirty(false),
+  mIsShutdown(false),
+  mNodeCount(0),
+  mNodeCapacity(0),
+  mRunCount(0),
+  mRecurringCount(0),
+  mFramesInFlight(NativeScheduler::DEFAULT_FRAMES_IN_FLIGHT),
+  mJobCapacity(0),
+  mSlotCapacity(0),
+  mIsPipelined(false),
+  mFrameCount(0),
+  mInboxHead(0),
+  mInboxSize(0),
+  mSleeping(0),
+  mStealCursor(0),
+  mIsExternalLoopBusy(false),
+  mOutstanding(0)
+{
+  /// Default to one worker per hardware thread, or per processor the policy uses
+  uint32_t count = workerCount;
+  if (!count && (affinity == Topology::Policy::NONE)) { count = boost::thread::hardware_concurrency(); }
+  if (!count && (affinity == Topology::Policy::NONE)) { count = 1; }
+  const Topology::ProcessorList placement = Topology().place(affinity, count);
+  count = placement.size();
+  this->mArenas.push_back(SharedPointer<FrameArena>(new FrameArena(count + 1)));
+
+  /// Each worker pins itself and then allocates its own state, so that the
+  /// memory is first touched on the worker's NUMA node
+  this->mStartup.reset(new boost::barrier(count + 1));
+  this->mWorkers.resize(count, NULL);
+  for (uint32_t index = 0; index < count; ++index)
+  {
+    this->mThreads.push_back(new boost::thread(boost::bind(&NativeScheduler::workerMain, this, index, placement[index])));
+  }
+  this->mStartup->wait();
+
+  /// Victim lists: same NUMA node first
+  std::vector<Worker*>::iterator
+    iter = this->mWorkers.begin(),
+    end = this->mWorkers.end();
+  for (; iter != end; ++iter)
+  {
+    Worker *worker = *iter;
+    for (uint32_t pass = 0; pass < 2; ++pass)
+    {
+      for (uint32_t index = 0; index < count; ++index)
+      {
+        Worker *victim = this->mWorkers[(worker->mIndex + index) % count];
+        if (victim == worker) { continue; }
+        if ((victim->mProcessor.mNode == worker->mProcessor.mNode) != (pass == 0)) { continue; }
+        worker->mVictims.push_back(victim);
+      }
+      if (pass == 0) { worker->mLocalVictimCount = worker->mVictims.size(); }
+    }
+  }
+
+  /// Release workers only once every worker may be stolen from
+  this->mStartup->wait();
+}
+
+NativeScheduler::~NativeScheduler()
+{
+  this->clear();
+
+  /// Stop worker threads
+  {
+    boost::mutex::scoped_lock lock(this->mSleepMutex);
+    this->mIsShutdown.store(true);
+    this->mSleepCondition.notify_all();
+  }
+
+  std::vector<boost::thread*>::iterator
+    threadIter = this->mThreads.begin(),
+    threadEnd = this->mThreads.end();
+  for (; threadIter != threadEnd; ++threadIter)
+  {
+    (*threadIter)->join();
+    delete *threadIter;
+  }
+  this->mThreads.clear();
+
+  /// Free workers only once no thread can still steal from them
+  std::vector<Worker*>::iterator
+    iter = this->mWorkers.begin(),
+    end = this->mWorkers.end();
+  for (; iter != end; ++iter)
+  {
+    delete *iter;
+  }
+  this->mWorkers.clear();
+}
+
+bool NativeScheduler::registerTask(const NativeScheduler::TaskType::Pointer task)
+{
+  if (!task) { return false; }
+  boost::mutex::scoped_lock lock(this->mTaskMutex);
+  TaskList::iterator iter = std::lower_bound(this->mTasks.begin(), this->mTasks.end(), task->getTaskId(), TaskCompare());
+  if ((iter != this->mTasks.end()) && ((*iter)->getTaskId() == task->getTaskId())) { return false; }
+  this->mTasks.insert(iter, task);
+
+  /// Update graph dirty flag
+  this->setIsGraphDirty(true);
+  return true;
+}
+
+bool NativeScheduler::unregisterTask(const NativeScheduler::TaskType::IdType taskId)
+{
+  boost::mutex::scoped_lock lock(this->mTaskMutex);
+  TaskList::iterator iter = std::lower_bound(this->mTasks.begin(), this->mTasks.end(), taskId, TaskCompare());
+  if ((iter == this->mTasks.end()) || ((*iter)->getTaskId() != taskId)) { return false; }
+  this->mTasks.erase(iter);
+
+  /// Update graph dirty flag
+  this->setIsGraphDirty(true);
+  return true;
+}
+
+///
+/// @note Registers a whole subgraph under one lock: the batch is sorted
+///   once and merged into the task list, rather than inserted task by
+///   task. Tasks already registered are skipped. Returns the number of
+///   tasks registered.
+///
+uint32_t NativeScheduler::registerTasks(const NativeScheduler::TaskList &tasks)
+{
+  /// Local vars
+  TaskList batch;
+
+  batch.reserve(tasks.size());
+  TaskList::const_iterator
+    iter = tasks.begin(),
+    end = tasks.end();
+  for (; iter != end; ++iter)
+  {
+    if (*iter) { batch.push_back(*iter); }
+  }
+  std::sort(batch.begin(), batch.end(), TaskCompare());
+
+  boost::mutex::scoped_lock lock(this->mTaskMutex);
+  const size_t count = this->mTasks.size();
+  this->mTasks.reserve(count + batch.size());
+  for (iter = batch.begin(), end = batch.end(); iter != end; ++iter)
+  {
+    const TaskType::IdType taskId = (*iter)->getTaskId();
+    if ((iter != batch.begin()) && ((*(iter - 1))->getTaskId() == taskId)) { continue; }
+    TaskList::const_iterator existing = std::lower_bound(this->mTasks.begin(), this->mTasks.begin() + count, taskId, TaskCompare());
+    if ((existing != this->mTasks.begin() + count) && ((*existing)->getTaskId() == taskId)) { continue; }
+    this->mTasks.push_back(*iter);
+  }
+  const uint32_t registered = this->mTasks.size() - count;
+  if (!registered) { return 0; }
+  std::inplace_merge(this->mTasks.begin(), this->mTasks.begin() + count, this->mTasks.end(), TaskCompare());
+
+  /// Update graph dirty flag
+  this->setIsGraphDirty(true);
+  return registered;
+}
+
+///
+/// @note Removes every listed task in one pass over the task list.
+///   Returns the number of tasks unregistered.
+///
+uint32_t NativeScheduler::unregisterTasks(const NativeScheduler::IdList &taskIds)
+{
+  /// Local vars
+  IdList sorted(taskIds);
+
+  std::sort(sorted.begin(), sorted.end());
+  boost::mutex::scoped_lock lock(this->mTaskMutex);
+  TaskList::iterator end = std::remove_if(this->mTasks.begin(), this->mTasks.end(), TaskListed(sorted));
+  const uint32_t unregistered = this->mTasks.end() - end;
+  if (!unregistered) { return 0; }
+  this->mTasks.erase(end, this->mTasks.end());
+
+  /// Update graph dirty flag
+  this->setIsGraphDirty(true);
+  return unregistered;
+}
+
+void NativeScheduler::schedule()
+{
+  /// Node counters must not be rebuilt under a running graph
+  this->wait();
+  boost::mutex::scoped_lock lock(this->mTaskMutex);
+
+  /// One node per registered task; node storage only grows
+  this->mNodeCount = this->mTasks.size();
+  if (this->mNodeCount > this->mNodeCapacity)
+  {
+    this->mNodes.reset(new Node[this->mNodeCount]);
+    this->mNodeCapacity = this->mNodeCount;
+  }
+  this->mRoots.clear();
+  this->mRecurringRoots.clear();
+  this->mRecurringCount = 0;
+  for (uint32_t index = 0; index < this->mNodeCount; ++index)
+  {
+    Node &node = this->mNodes[index];
+    node.mTask = this->mTasks[index];
+    node.mPriority = std::max<uint32_t>(
+      Task::Priority::LOW,
+      std::min<uint32_t>(Task::Priority::HIGH, node.mTask->getPriority()));
+    node.mCriticalPath = 0;
+    node.mPredecessorCount = 0;
+    node.mRecurringPredecessorCount = 0;
+    node.mNextFrame.store(0, std::memory_order_relaxed);
+    node.mDeferredFrames.store(0, std::memory_order_relaxed);
+    node.mSuccessors.clear();
+  }
+
+  /// Release tasks held by nodes beyond the current graph
+  for (uint32_t index = this->mNodeCount; index < this->mNodeCapacity; ++index)
+  {
+    this->mNodes[index].mTask.reset();
+  }
+
+  /// Create task graph edges; a task joins on all of its registered dependencies
+  for (uint32_t index = 0; index < this->mNodeCount; ++index)
+  {
+    Node &node = this->mNodes[index];
+    const TaskType::DependencyList &dependencies = node.mTask->getDependencies();
+    TaskType::DependencyList::const_iterator
+      dependencyIter = dependencies.begin(),
+      dependencyEnd = dependencies.end();
+    for (; dependencyIter != dependencyEnd; ++dependencyIter)
+    {
+      /// Node indices follow task IDs, so dependencies resolve by binary search
+      TaskList::const_iterator parent = std::lower_bound(this->mTasks.begin(), this->mTasks.end(), *dependencyIter, TaskCompare());
+      if ((parent == this->mTasks.end()) || ((*parent)->getTaskId() != *dependencyIter)) { continue; }
+      Node &parentNode = this->mNodes[parent - this->mTasks.begin()];
+      parentNode.mSuccessors.push_back(index);
+      ++node.mPredecessorCount;
+      if (parentNode.mTask->getRecurring()) { ++node.mRecurringPredecessorCount; }
+    }
+
+    /// Task has no (registered) dependency
+    if (!node.mPredecessorCount) { this->mRoots.push_back(index); }
+
+    /// Pipelined runs only wait on recurring dependencies
+    if (node.mTask->getRecurring())
+    {
+      ++this->mRecurringCount;
+      if (!node.mRecurringPredecessorCount) { this->mRecurringRoots.push_back(index); }
+    }
+  }
+
+  /// One job per node and frame slot; job storage only grows
+  const uint32_t slots = this->mFramesInFlight;
+  if (this->mNodeCount * slots > this->mJobCapacity)
+  {
+    this->mJobs.reset(new Job[this->mNodeCount * slots]);
+    this->mJobCapacity = this->mNodeCount * slots;
+  }
+  if (slots > this->mSlotCapacity)
+  {
+    this->mSlotOutstanding.reset(new std::atomic<uint32_t>[slots]);
+    this->mSlotStart.reset(new uint64_t[slots]);
+    this->mSlotCapacity = slots;
+  }
+  while (this->mArenas.size() < slots)
+  {
+    this->mArenas.push_back(SharedPointer<FrameArena>(new FrameArena(this->mWorkers.size() + 1)));
+  }
+  for (uint32_t index = 0; index < this->mNodeCount; ++index)
+  {
+    for (uint32_t slot = 0; slot < slots; ++slot)
+    {
+      Job &job = this->mJobs[index * slots + slot];
+      job.mNode = &this->mNodes[index];
+      job.mSlot = slot;
+      job.mFrame = 0;
+      job.mIsParked.store(false, std::memory_order_relaxed);
+      job.mSuspension.bind(&NativeScheduler::resume, this, &job);
+    }
+  }
+
+  this->mRunCount = 0;
+  this->updateCriticalPath();
+
+  /// Update graph dirty flag
+  this->setIsGraphDirty(false);
+}
+
+NativeScheduler::HandleType NativeScheduler::run(NativeScheduler::TaskType::InputType input, const bool wait)
+{
+  /// Only one run of the graph may be in flight
+  this->wait();
+  if (this->getIsGraphDirty()) { this->schedule(); }
+  if (!this->mNodeCount) { return HandleType(); }
+  if ((++this->mRunCount % NativeScheduler::CRITICAL_PATH_INTERVAL) == 0) { this->updateCriticalPath(); }
+
+  /// Run every task once, as a single frame
+  this->mInput = input;
+  this->mIsPipelined = false;
+  this->mFrameCount = 1;
+  this->mOutstanding.store(1, std::memory_order_release);
+  const HandleType handle(this, this->mRuns.begin());
+  this->launch(0, NULL);
+
+  if (wait) { this->wait(); }
+  return handle;
+}
+
+///
+/// @note Runs the recurring tasks frameCount times. Frame N+1 starts as soon
+///   as a frame slot is free, so a task may run in frame N+1 before its
+///   successors have finished frame N. Serial tasks still see their own
+///   frames one at a time and in order; parallel tasks must tolerate
+///   concurrent calls. Frame numbers continue from input.mIndex.
+///
+NativeScheduler::HandleType NativeScheduler::pipeline(const uint32_t frameCount, NativeScheduler::TaskType::InputType input, const bool wait)
+{
+  /// Only one run of the graph may be in flight
+  this->wait();
+  if (this->getIsGraphDirty()) { this->schedule(); }
+  if (!frameCount || !this->mRecurringCount) { return HandleType(); }
+  if ((++this->mRunCount % NativeScheduler::CRITICAL_PATH_INTERVAL) == 0) { this->updateCriticalPath(); }
+
+  /// Reset per-run counters
+  this->mInput = input;
+  this->mIsPipelined = true;
+  this->mFrameCount = frameCount;
+  for (uint32_t index = 0; index < this->mNodeCount; ++index)
+  {
+    this->mNodes[index].mNextFrame.store(0, std::memory_order_relaxed);
+    this->mNodes[index].mTask->setInputSlots(this->mFramesInFlight);
+  }
+  this->mOutstanding.store(frameCount, std::memory_order_release);
+  const HandleType handle(this, this->mRuns.begin());
+
+  /// Fill the frame slots; later frames are launched as earlier ones complete
+  const uint32_t initial = std::min(frameCount, this->mFramesInFlight);
+  for (uint32_t frame = 0; frame < initial; ++frame)
+  {
+    this->launch(frame, NULL);
+  }
+
+  if (wait) { this->wait(); }
+  return handle;
+}
+
+void NativeScheduler::wait()
+{
+  this->wait(this->mRuns.getCurrent(), RunTracker::INFINITE);
+}
+
+///
+/// @note The waiting thread runs the main-thread tasks, and any other
+///   ready task while none of those is queued, until the run completes.
+///   Returns false if it has not completed within timeout microseconds,
+///   measured on the monotonic timer clock.
+///
+bool NativeScheduler::wait(const uint64_t run, const uint64_t timeout)
+{
+  /// Local vars
+  Worker *worker = this->getCurrentWorker();
+  Job *job = NULL;
+  const bool isTimed = (timeout != RunTracker::INFINITE);
+  const uint64_t deadline = Utilities::BasicTimer::now() + (isTimed ? timeout * Utilities::Timer::NSEC_PER_USEC : 0);
+  uint64_t now = 0;
+
+  while (!this->mRuns.isComplete(run))
+  {
+    now = Utilities::BasicTimer::now();
+    if (isTimed && (now >= deadline)) { return false; }
+    job = this->acquireMain();
+    if (!job) { job = worker ? this->acquire(worker) : this->acquireExternal(); }
+    if (job)
+    {
+      this->execute(job, worker);
+      continue;
+    }
+
+    boost::mutex::scoped_lock lock(this->mDoneMutex);
+    if (!this->mMainQueue.empty() || this->mRuns.isComplete(run)) { continue; }
+    if (!isTimed) { this->mDoneCondition.wait(lock); }
+    else { this->mDoneCondition.timed_wait(lock, boost::posix_time::microseconds((deadline - now) / Utilities::Timer::NSEC_PER_USEC + 1)); }
+  }
+  return true;
+}
+
+void NativeScheduler::clear()
+{
+  this->wait();
+  boost::mutex::scoped_lock lock(this->mTaskMutex);
+  this->mTasks.clear();
+  this->mNodes.reset();
+  this->mJobs.reset();
+  this->mNodeCount = 0;
+  this->mNodeCapacity = 0;
+  this->mJobCapacity = 0;
+  this->mRoots.clear();
+  this->mRecurringRoots.clear();
+  this->mRecurringCount = 0;
+  this->setIsGraphDirty(false);
+}
+
+void NativeScheduler::setFramesInFlight(const uint32_t framesInFlight)
+{
+  this->wait();
+  boost::mutex::scoped_lock lock(this->mTaskMutex);
+  this->mFramesInFlight = std::max<uint32_t>(1, framesInFlight);
+
+  /// Update graph dirty flag; jobs are reallocated by the next schedule()
+  this->setIsGraphDirty(true);
+}
+
+///
+/// @note Ranks each task by the longest chain of measured durations from it
+///   to a sink, then orders roots and successor lists so that workers start
+///   on the critical path first.
+///
+void NativeScheduler::updateCriticalPath()
+{
+  /// Local vars
+  uint32_t_v &order = this->mOrder, &pending = this->mPending;
+  order.assign(this->mRoots.begin(), this->mRoots.end());
+  pending.resize(this->mNodeCount);
+
+  /// Topological order (Kahn)
+  for (uint32_t index = 0; index < this->mNodeCount; ++index)
+  {
+    pending[index] = this->mNodes[index].mPredecessorCount;
+  }
+  for (uint32_t cursor = 0; cursor < order.size(); ++cursor)
+  {
+    const uint32_t_v &successors = this->mNodes[order[cursor]].mSuccessors;
+    uint32_t_v::const_iterator
+      iter = successors.begin(),
+      end = successors.end();
+    for (; iter != end; ++iter)
+    {
+      if (--pending[*iter] == 0) { order.push_back(*iter); }
+    }
+  }
+
+  /// Accumulate path lengths from the sinks upwards
+  uint32_t_v::reverse_iterator
+    orderIter = order.rbegin(),
+    orderEnd = order.rend();
+  for (; orderIter != orderEnd; ++orderIter)
+  {
+    Node &node = this->mNodes[*orderIter];
+    uint64_t longest = 0;
+    uint32_t_v::const_iterator
+      iter = node.mSuccessors.begin(),
+      end = node.mSuccessors.end();
+    for (; iter != end; ++iter)
+    {
+      longest = std::max(longest, this->mNodes[*iter].mCriticalPath);
+    }
+    node.mCriticalPath = std::max<uint64_t>(1, node.mTask->getDuration()) + longest;
+    std::sort(node.mSuccessors.begin(), node.mSuccessors.end(), SuccessorCompare(this->mNodes.get()));
+  }
+
+  /// Hand out higher-priority, then longer-path roots first
+  std::sort(this->mRoots.begin(), this->mRoots.end(), RootCompare(this->mNodes.get()));
+}
+
+void NativeScheduler::workerMain(const uint32_t index, const Topology::Processor processor)
+{
+  /// Pin first, so that the worker's deques are allocated on its own node
+  Topology::pin(processor);
+  Worker *worker = new Worker(index, processor);
+  this->mWorkers[index] = worker;
+  this->mStartup->wait();
+  this->mStartup->wait();
+
+  NativeScheduler::CURRENT_WORKER = worker;
+  uint32_t failures = 0;
+  while (!this->mIsShutdown.load(std::memory_order_relaxed))
+  {
+    Job *job = this->acquire(worker);
+    if (job)
+    {
+      this->execute(job, worker);
+      failures = 0;
+      continue;
+    }
+
+    /// Spin briefly before going to sleep
+    if (++failures < NativeScheduler::STEAL_ATTEMPTS)
+    {
+      boost::this_thread::yield();
+      continue;
+    }
+    this->sleep();
+    failures = 0;
+  }
+  NativeScheduler::CURRENT_WORKER = NULL;
+}
+
+bool NativeScheduler::isActive(const NativeScheduler::Node &node) const
+{
+  return (!this->mIsPipelined || node.mTask->getRecurring());
+}
+
+void NativeScheduler::launch(int64_t frame, NativeScheduler::Worker *worker)
+{
+  /// @note Loops instead of recursing when a frame completes during its own launch
+  while ((frame >= 0) && this->start(frame, worker))
+  {
+    frame = this->retire(frame);
+  }
+}
+
+///
+/// @note Returns true if the frame completed before start() returned. The
+///   slot counter holds one extra reference until all roots are handed out,
+///   so the slot cannot be relaunched under this loop.
+///
+bool NativeScheduler::start(const int64_t frame, NativeScheduler::Worker *worker)
+{
+  /// Local vars
+  const uint32_t slots = this->mFramesInFlight;
+  const uint32_t slot = frame % slots;
+  const uint32_t_v &roots = this->mIsPipelined ? this->mRecurringRoots : this->mRoots;
+
+  /// Reset the jobs of this frame slot; the frame it last held has completed
+  for (uint32_t index = 0; index < this->mNodeCount; ++index)
+  {
+    Node &node = this->mNodes[index];
+    if (!this->isActive(node)) { continue; }
+    Job &job = this->mJobs[index * slots + slot];
+    job.mFrame = frame;
+    job.mPending.store(this->mIsPipelined ? node.mRecurringPredecessorCount : node.mPredecessorCount, std::memory_order_relaxed);
+    job.mIsParked.store(false, std::memory_order_relaxed);
+  }
+  this->mSlotStart[slot] = FrameBudget::now();
+  this->mSlotOutstanding[slot].store((this->mIsPipelined ? this->mRecurringCount : this->mNodeCount) + 1, std::memory_order_release);
+
+  /// Hand root tasks to the workers
+  uint32_t_v::const_iterator
+    iter = roots.begin(),
+    end = roots.end();
+  for (; iter != end; ++iter)
+  {
+    this->ready(&this->mJobs[*iter * slots + slot], worker);
+  }
+  if (!worker)
+  {
+    boost::mutex::scoped_lock lock(this->mSleepMutex);
+    this->mSleepCondition.notify_all();
+  }
+  return (this->mSlotOutstanding[slot].fetch_sub(1, std::memory_order_acq_rel) == 1);
+}
+
+///
+/// @note Called once the last job of a frame completes. Returns the frame to
+///   launch into the freed slot, or -1 if there is none.
+///
+int64_t NativeScheduler::retire(const int64_t frame)
+{
+  /// Local vars
+  const int64_t next = frame + this->mFramesInFlight;
+  const bool isLaunching = this->mIsPipelined && (next < this->mFrameCount);
+
+  this->mBudget.completeFrame(this->mSlotStart[frame % this->mFramesInFlight]);
+
+  /// Every task of the frame has completed, so its temporaries can go
+  /// before the next frame launches into the slot
+  this->mArenas[frame % this->mFramesInFlight]->reset();
+
+  /// Signal waiters when the last frame of the run completes; continuations
+  /// come last, since they may start the next run
+  if (this->mOutstanding.fetch_sub(1, std::memory_order_acq_rel) == 1)
+  {
+    const bool hasContinuations = this->mRuns.complete();
+    {
+      boost::mutex::scoped_lock lock(this->mDoneMutex);
+      this->mDoneCondition.notify_all();
+    }
+    if (hasContinuations) { this->mRuns.callContinuations(); }
+  }
+  return isLaunching ? next : -1;
+}
+
+///
+/// @note A serial stage may only run frame N once it has finished frame
+///   N - 1. A job that becomes ready too early parks itself; whichever of
+///   the two sides clears the park flag submits the job. Both sides use
+///   sequentially consistent operations, so at least one of them sees the
+///   other.
+///
+void NativeScheduler::ready(NativeScheduler::Job *job, NativeScheduler::Worker *worker)
+{
+  if (this->mIsPipelined && job->mNode->mTask->getSerial())
+  {
+    job->mIsParked.store(true);
+    if (job->mNode->mNextFrame.load() < job->mFrame) { return; }
+    if (!job->mIsParked.exchange(false)) { return; }
+  }
+  this->submit(job, worker);
+}
+
+void NativeScheduler::execute(NativeScheduler::Job *job, NativeScheduler::Worker *worker)
+{
+  if (job->mLoop)
+  {
+    this->executeLoop(job, worker);
+    return;
+  }
+
+  /// Local vars
+  Node *node = job->mNode;
+  const uint32_t slots = this->mFramesInFlight;
+  const uint32_t index = node - this->mNodes.get();
+  const bool isSerial = node->mTask->getSerial();
+  const uint64_t frameStart = this->mSlotStart[job->mSlot];
+
+  const Frame frame = this->mIsPipelined ? Frame(this->mInput.mIndex + job->mFrame, job->mSlot) : this->mInput;
+
+  /// Skip this frame if the frame is at risk of overrunning its budget, or
+  /// if no input has changed since the last run; a resumed task is never skipped
+  bool isSkipped = false;
+  if (!job->mSuspension.getPoint())
+  {
+    const uint32_t deferredFrames = node->mDeferredFrames.load(std::memory_order_relaxed);
+    const bool isShed = this->mBudget.shed(frameStart, node->mCriticalPath, node->mPriority, node->mTask->getRecurring(), deferredFrames);
+    node->mDeferredFrames.store(isShed ? deferredFrames + 1 : 0, std::memory_order_relaxed);
+
+    /// @note Outputs are reused per Port slot, as the frames in flight each have their own
+    isSkipped = isShed || node->mTask->isUpToDate(job->mSlot);
+    if (!isSkipped) { node->mTask->captureInputs(job->mSlot); }
+  }
+  if (!isSkipped)
+  {
+    /// Call the task again at once if its completion arrived before it returned
+    uint32_t state = Suspension::State::NONE;
+    Suspension *previous = Suspension::setCurrent(&job->mSuspension);
+    FrameArena *arena = FrameArena::setCurrent(this->mArenas[job->mSlot].get());
+    do
+    {
+      const uint64_t start = Utilities::BasicTimer::now();
+      {
+        RSSD_TRACE_TASK(this->mTracer, *node->mTask, frame.mIndex, worker ? worker->mIndex : this->mWorkers.size());
+        node->mTask->getFunctor()(frame);
+      }
+      job->mElapsed += Utilities::BasicTimer::now() - start;
+      state = job->mSuspension.settle();
+    } while (state == Suspension::State::RESUMED);
+    FrameArena::setCurrent(arena);
+    Suspension::setCurrent(previous);
+
+    /// Suspended; the worker moves on and resume() resubmits the job
+    if (state == Suspension::State::SUSPENDED) { return; }
+
+    /// @note Parallel stages of a pipelined run may overlap with themselves
+    if (!this->mIsPipelined || isSerial) { node->mTask->sampleDuration(job->mElapsed / Utilities::Timer::NSEC_PER_USEC); }
+    job->mElapsed = 0;
+    node->mTask->publishOutput();
+    this->mBudget.completeTask(frameStart, node->mTask->getDeadline());
+  }
+
+  /// Release successors in this frame whose last predecessor just completed
+  uint32_t_v::iterator
+    iter = node->mSuccessors.begin(),
+    end = node->mSuccessors.end();
+  for (; iter != end; ++iter)
+  {
+    if (!this->isActive(this->mNodes[*iter])) { continue; }
+    Job *successor = &this->mJobs[*iter * slots + job->mSlot];
+    if (successor->mPending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      this->ready(successor, worker);
+    }
+  }
+
+  /// Hand a serial stage over to its next frame
+  if (this->mIsPipelined && isSerial)
+  {
+    Job *next = &this->mJobs[index * slots + ((job->mFrame + 1) % slots)];
+    node->mNextFrame.store(job->mFrame + 1);
+    if (next->mIsParked.exchange(false)) { this->submit(next, worker); }
+  }
+
+  /// Reuse the frame slot once its last job completes
+  const int64_t retired = job->mFrame;
+  if (this->mSlotOutstanding[job->mSlot].fetch_sub(1, std::memory_order_acq_rel) != 1) { return; }
+  this->launch(this->retire(retired), worker);
+}
+
+NativeScheduler::Job* NativeScheduler::acquire(NativeScheduler::Worker *worker)
+{
+  /// Local vars
+  Job *job = NULL;
+  const uint32_t levels = Task::Priority::HIGH - Task::Priority::LOW + 1;
+  const bool isAging = ((++worker->mAcquisitions % NativeScheduler::STARVATION_LIMIT) == 0);
+
+  /// Own deques first (LIFO, cache-warm), highest priority first
+  for (uint32_t step = 0; step < levels; ++step)
+  {
+    if (worker->mDeques[NativeScheduler::toLevel(step, isAging)].pop(job)) { return job; }
+  }
+
+  /// Externally submitted work
+  if (this->mInboxSize.load(std::memory_order_acquire) > 0)
+  {
+    /// Take a fair share of the inbox so that wide root sets spread
+    /// through stealing instead of contending on the inbox lock
+    boost::mutex::scoped_lock lock(this->mInboxMutex);
+    if (this->mInboxHead < this->mInbox.size())
+    {
+      const uint32_t share = std::max<uint32_t>(1, (this->mInbox.size() - this->mInboxHead) / this->mWorkers.size());
+      job = this->mInbox[this->mInboxHead++];
+      for (uint32_t index = 1; index < share; ++index)
+      {
+        Job *shared = this->mInbox[this->mInboxHead++];
+        worker->mDeques[shared->getPriority()].push(shared);
+      }
+      this->compactInbox();
+      this->mInboxSize.fetch_sub(share, std::memory_order_relaxed);
+      lock.unlock();
+      if (share > 1) { this->notify(); }
+      return job;
+    }
+  }
+
+  /// Steal from randomly chosen victims
+  return this->steal(worker, worker->random(), isAging);
+}
+
+///
+/// @note Used by threads outside the pool that wait on a loop.
+///
+NativeScheduler::Job* NativeScheduler::acquireExternal()
+{
+  /// Local vars
+  Job *job = NULL;
+
+  if (this->mInboxSize.load(std::memory_order_acquire) > 0)
+  {
+    boost::mutex::scoped_lock lock(this->mInboxMutex);
+    if (this->mInboxHead < this->mInbox.size())
+    {
+      job = this->mInbox[this->mInboxHead++];
+      this->compactInbox();
+      this->mInboxSize.fetch_sub(1, std::memory_order_relaxed);
+      return job;
+    }
+  }
+  return this->steal(NULL, this->mStealCursor.fetch_add(1, std::memory_order_relaxed), false);
+}
+
+///
+/// @note Workers try victims on their own NUMA node before remote ones, at
+///   each priority level. Threads outside the pool try all workers.
+///
+NativeScheduler::Job* NativeScheduler::steal(const NativeScheduler::Worker *thief, const uint32_t start, const bool isAging)
+{
+  /// Local vars
+  Job *job = NULL;
+  const uint32_t levels = Task::Priority::HIGH - Task::Priority::LOW + 1;
+
+  /// Highest priority first
+  for (uint32_t step = 0; step < levels; ++step)
+  {
+    const uint32_t level = NativeScheduler::toLevel(step, isAging);
+    if (!thief)
+    {
+      job = NativeScheduler::steal(&this->mWorkers[0], this->mWorkers.size(), start, level);
+      if (job) { return job; }
+      continue;
+    }
+
+    const std::vector<Worker*> &victims = thief->mVictims;
+    if (victims.empty()) { continue; }
+    const uint32_t local = thief->mLocalVictimCount;
+    if (local) { job = NativeScheduler::steal(&victims[0], local, start, level); }
+    if (job) { return job; }
+    if (local < victims.size()) { job = NativeScheduler::steal(&victims[local], victims.size() - local, start, level); }
+    if (job) { return job; }
+  }
+  return NULL;
+}
+
+NativeScheduler::Job* NativeScheduler::steal(NativeScheduler::Worker * const *victims, const uint32_t count, const uint32_t start, const uint32_t level)
+{
+  /// Local vars
+  Job *job = NULL;
+
+  for (uint32_t offset = 0; offset < count; ++offset)
+  {
+    if (victims[(start + offset) % count]->mDeques[level].steal(job)) { return job; }
+  }
+  return NULL;
+}
+
+void NativeScheduler::submit(NativeScheduler::Job *job, NativeScheduler::Worker *worker)
+{
+  /// Main-thread tasks are handed to the waiting thread
+  if (job->mNode && job->mNode->mTask->getMainThread())
+  {
+    boost::mutex::scoped_lock lock(this->mDoneMutex);
+    this->mMainQueue.push_back(job);
+    this->mDoneCondition.notify_all();
+    return;
+  }
+
+  if (worker)
+  {
+    worker->mDeques[job->getPriority()].push(job);
+    this->notify();
+    return;
+  }
+
+  /// Submitted from outside the pool
+  {
+    boost::mutex::scoped_lock lock(this->mInboxMutex);
+    this->mInbox.push_back(job);
+    this->mInboxSize.fetch_add(1, std::memory_order_release);
+  }
+  this->notify();
+}
+
+///
+/// @note Called with the inbox lock held. Drops consumed entries so that
+///   the inbox reuses its storage instead of growing.
+///
+void NativeScheduler::compactInbox()
+{
+  if (this->mInboxHead == this->mInbox.size())
+  {
+    this->mInbox.clear();
+    this->mInboxHead = 0;
+  }
+  else if (this->mInboxHead >= (this->mInbox.size() / 2))
+  {
+    this->mInbox.erase(this->mInbox.begin(), this->mInbox.begin() + this->mInboxHead);
+    this->mInboxHead = 0;
+  }
+}
+
+///
+/// @note Takes the ready main-thread task of the highest priority.
+///
+NativeScheduler::Job* NativeScheduler::acquireMain()
+{
+  boost::mutex::scoped_lock lock(this->mDoneMutex);
+  if (this->mMainQueue.empty()) { return NULL; }
+
+  std::vector<Job*>::iterator
+    best = this->mMainQueue.begin(),
+    iter = this->mMainQueue.begin(),
+    end = this->mMainQueue.end();
+  for (++iter; iter != end; ++iter)
+  {
+    if ((*iter)->getPriority() > (*best)->getPriority()) { best = iter; }
+  }
+  Job *job = *best;
+  *best = this->mMainQueue.back();
+  this->mMainQueue.pop_back();
+  return job;
+}
+
+///
+/// @note Resumption callback of a suspended job; runs on the thread that
+///   signalled the completion.
+///
+void NativeScheduler::resume(void *scheduler, void *job)
+{
+  NativeScheduler *self = static_cast<NativeScheduler*>(scheduler);
+  self->submit(static_cast<Job*>(job), self->getCurrentWorker());
+}
+
+///
+/// @note Picks the grain from the cost observed for this body type: chunks
+///   of about LOOP_CHUNK_NANOSECONDS, but at least one chunk per worker and
+///   at most LOOP_CHUNKS_PER_WORKER. Before any cost has been observed, the
+///   range is split into eight chunks per worker.
+///
+void NativeScheduler::runLoop(NativeScheduler::Loop &loop, const size_t begin, const size_t end)
+{
+  /// Local vars
+  const size_t count = end - begin;
+  const size_t workers = this->mWorkers.size();
+  const uint64_t cost = loop.mCost->load(std::memory_order_relaxed);
+  const size_t finest = (count + workers * NativeScheduler::LOOP_CHUNKS_PER_WORKER - 1) / (workers * NativeScheduler::LOOP_CHUNKS_PER_WORKER);
+  const size_t coarsest = (count + workers - 1) / workers;
+  size_t grain = cost
+    ? static_cast<size_t>((NativeScheduler::LOOP_CHUNK_NANOSECONDS * 256) / cost)
+    : ((count + workers * 8 - 1) / (workers * 8));
+  grain = std::max<size_t>(1, std::max(finest, std::min(coarsest, grain)));
+
+  /// Reuse this thread's job storage. A thread outside the pool borrows
+  /// the scheduler's spare storage, and only allocates while another
+  /// outside thread holds it.
+  Worker *worker = this->getCurrentWorker();
+  LoopStorage *storage = worker ? &worker->mLoops : NativeScheduler::EXTERNAL_LOOPS;
+  const bool isClaimed = !storage && !this->mIsExternalLoopBusy.exchange(true, std::memory_order_acquire);
+  if (isClaimed)
+  {
+    storage = &this->mExternalLoops;
+    NativeScheduler::EXTERNAL_LOOPS = storage;
+  }
+
+  /// Halving stops at chunks larger than half the grain, so there are at
+  /// most 2 * count / grain of them
+  const size_t capacity = 2 * ((count + grain - 1) / grain);
+  boost::scoped_array<Job> jobs(storage ? NULL : new Job[capacity]);
+  loop.mGrain = grain;
+  loop.mJobs = storage ? storage->push(capacity) : jobs.get();
+  loop.mPending.store(1, std::memory_order_relaxed);
+
+  /// Run the whole range as the first chunk, then help until all chunks are done
+  Job root;
+  root.mLoop = &loop;
+  root.mBegin = begin;
+  root.mEnd = end;
+  this->executeLoop(&root, worker);
+  this->help(loop.mPending, worker);
+
+  if (storage) { storage->pop(); }
+  if (isClaimed)
+  {
+    NativeScheduler::EXTERNAL_LOOPS = NULL;
+    this->mIsExternalLoopBusy.store(false, std::memory_order_release);
+  }
+}
+
+void NativeScheduler::executeLoop(NativeScheduler::Job *job, NativeScheduler::Worker *worker)
+{
+  /// Local vars
+  Loop *loop = job->mLoop;
+  const size_t begin = job->mBegin;
+  size_t end = job->mEnd;
+
+  /// Split off upper halves for other workers to steal
+  while ((end - begin) > loop->mGrain)
+  {
+    const size_t middle = begin + (end - begin) / 2;
+    Job *split = &loop->mJobs[loop->mJobCount.fetch_add(1, std::memory_order_relaxed)];
+    split->mLoop = loop;
+    split->mBegin = middle;
+    split->mEnd = end;
+    loop->mPending.fetch_add(1, std::memory_order_relaxed);
+    this->submit(split, worker);
+    end = middle;
+  }
+
+  FrameArena *arena = FrameArena::setCurrent(loop->mArena);
+  const uint64_t start = Utilities::BasicTimer::now();
+  loop->mInvoke(loop->mBody, begin, end);
+  const uint64_t elapsed = Utilities::BasicTimer::now() - start;
+  FrameArena::setCurrent(arena);
+
+  /// Fold the observed cost per iteration into the estimate for this body type
+  const uint64_t sample = std::max<uint64_t>(1, (elapsed * 256) / (end - begin));
+  const uint64_t cost = loop->mCost->load(std::memory_order_relaxed);
+  loop->mCost->store(cost ? ((cost * 3 + sample) / 4) : sample, std::memory_order_relaxed);
+
+  /// @note The caller may destroy the loop as soon as this reaches zero
+  loop->mPending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+///
+/// @note Runs other ready work, including chunks of nested loops, instead of
+///   blocking, so a worker that waits inside a task keeps the pool busy.
+///   With nothing to help with, it yields for a while and then naps for
+///   exponentially longer periods, up to HELP_MAX_BACKOFF_MICROSECONDS.
+///
+void NativeScheduler::help(const std::atomic<uint32_t> &pending, NativeScheduler::Worker *worker)
+{
+  /// Local vars
+  uint32_t failures = 0;
+  uint32_t backoff = 1;
+
+  while (pending.load(std::memory_order_acquire) != 0)
+  {
+    Job *job = worker ? this->acquire(worker) : this->acquireExternal();
+    if (job)
+    {
+      this->execute(job, worker);
+      failures = 0;
+      backoff = 1;
+      continue;
+    }
+
+    if (++failures < NativeScheduler::STEAL_ATTEMPTS)
+    {
+      boost::this_thread::yield();
+      continue;
+    }
+    boost::this_thread::sleep(boost::posix_time::microseconds(backoff));
+    backoff = std::min<uint32_t>(backoff * 2, NativeScheduler::HELP_MAX_BACKOFF_MICROSECONDS);
+  }
+}
+
+NativeScheduler::Worker* NativeScheduler::getCurrentWorker() const
+{
+  /// @note A worker of another scheduler counts as an outside thread here
+  Worker *worker = NativeScheduler::CURRENT_WORKER;
+  if (!worker || (worker->mIndex >= this->mWorkers.size()) || (this->mWorkers[worker->mIndex] != worker)) { return NULL; }
+  return worker;
+}
+
+void NativeScheduler::notify()
+{
+  /// @note Pairs with the increment in sleep() so that either the sleeper
+  ///   sees the new work or this thread sees the sleeper.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (this->mSleeping.load(std::memory_order_relaxed) == 0) { return; }
+
+  boost::mutex::scoped_lock lock(this->mSleepMutex);
+  this->mSleepCondition.notify_one();
+}
+
+void NativeScheduler::sleep()
+{
+  boost::mutex::scoped_lock lock(this->mSleepMutex);
+  this->mSleeping.fetch_add(1, std::memory_order_seq_cst);
+  if (!this->mIsShutdown.load() && !this->hasWork())
+  {
+    this->mSleepCondition.wait(lock);
+  }
+  this->mSleeping.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool NativeScheduler::hasWork() const
+{
+  if (this->mInboxSize.load(std::memory_order_acquire) > 0) { return true; }
+  std::vector<Worker*>::const_iterator
+    iter = this->mWorkers.begin(),
+    end = this->mWorkers.end();
+  for (; iter != end; ++iter)
+  {
+    for (uint32_t level = Task::Priority::LOW; level <= Task::Priority::HIGH; ++level)
+    {
+      if (!(*iter)->mDeques[level].empty()) { return true; }
+    }
+  }
+  return false;
+}
+
+uint32_t NativeScheduler::toLevel(const uint32_t step, const bool isAging)
+{
+  return isAging ? (Task::Priority::LOW + step) : (Task::Priority::HIGH - step);
+}
+
+///
+/// @class NativeScheduler::LoopStorage
+///
+
+NativeScheduler::LoopStorage::~LoopStorage()
+{
+  std::vector<Job*>::iterator
+    iter = this->mLevels.begin(),
+    end = this->mLevels.end();
+  for (; iter != end; ++iter)
+  {
+    delete[] *iter;
+  }
+}
+
+///
+/// @note Returns storage for at least count jobs at the next nesting depth.
+///
+NativeScheduler::Job* NativeScheduler::LoopStorage::push(const size_t count)
+{
+  if (this->mDepth == this->mLevels.size())
+  {
+    this->mLevels.push_back(NULL);
+    this->mCapacities.push_back(0);
+  }
+  if (this->mCapacities[this->mDepth] < count)
+  {
+    delete[] this->mLevels[this->mDepth];
+    this->mLevels[this->mDepth] = new Job[count];
+    this->mCapacities[this->mDepth] = count;
+  }
+  return this->mLevels[this->mDepth++];
+}
@@ -0,0 +1,289 @@
+///
+/// @file NativeScheduler.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by The Secret Design Collective
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+///     this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+///     this list of conditions and the following disclaimer in the documentation
+///     and/or other materials provided with the distribution.
+///    * Neither the name of The Secret Design Collective nor the names of its
+///     contributors may be used to endorse or promote products derived from
+///     this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+#ifndef RSSD_CORE_CONCURRENCY_IMPL_NATIVESCHEDULER_H
+#define RSSD_CORE_CONCURRENCY_IMPL_NATIVESCHEDULER_H
+
+#include "System"
+#include "Utilities"
+#include "concurrency/Completion.h"
+#include "concurrency/FrameArena.h"
+#include "concurrency/FrameBudget.h"
+#include "concurrency/RunHandle.h"
+#include "concurrency/Trace.h"
+#include "concurrency/native/NativeTraits.h"
+#include "concurrency/native/Topology.h"
+#include "concurrency/native/WorkStealingDeque.h"
+
+namespace RSSD {
+namespace Core {
+namespace Concurrency {
+namespace Impl {
+
+///
+/// @brief Work-stealing scheduler backend with no TBB dependency.
+/// @note Each worker owns one Chase-Lev deque per priority level. Ready
+///   successors go onto the deques of the worker that released them, and
+///   idle workers steal from randomly chosen victims.
+///
+class NativeScheduler
+{
+public:
+  typedef NativeTraits::TaskType TaskType;
+  typedef std::vector<TaskType::Pointer> TaskList; /// @note Ascending by task ID
+  typedef std::vector<TaskType::IdType> IdList;
+  typedef RunHandle<NativeScheduler> HandleType;
+
+  struct Node
+  {
+    Node() : mPriority(Task::Priority::MEDIUM), mCriticalPath(0), mPredecessorCount(0), mRecurringPredecessorCount(0), mNextFrame(0), mDeferredFrames(0) {}
+
+    TaskType::Pointer mTask;
+    uint32_t mPriority; /// @note Clamped to [Priority::LOW, Priority::HIGH]
+    uint64_t mCriticalPath; /// @note Longest measured path (us) from this task to the end of the graph
+    uint32_t mPredecessorCount;
+    uint32_t mRecurringPredecessorCount; /// @note Predecessors that take part in a pipelined run
+    std::atomic<int64_t> mNextFrame; /// @note Next frame a serial stage may execute in a pipelined run
+    std::atomic<uint32_t> mDeferredFrames; /// @note Consecutive frames this task has been shed from
+    uint32_t_v mSuccessors; /// @note Indices into the node array, ascending by critical path
+  }; /// struct Node
+
+  ///
+  /// @brief One execution of a node in one frame.
+  /// @note Frame N of a pipelined run uses the jobs of slot N % frames in flight,
+  ///   so up to that many frames progress through the graph at once.
+  ///
+  struct Loop;
+  struct Job
+  {
+    Job() : mNode(NULL), mSlot(0), mFrame(0), mPending(0), mIsParked(false), mElapsed(0), mLoop(NULL), mBegin(0), mEnd(0) {}
+    FORCE_INLINE uint32_t getPriority() const { return this->mNode ? this->mNode->mPriority : Task::Priority::HIGH; }
+
+    Node *mNode;
+    uint32_t mSlot;
+    int64_t mFrame;
+    std::atomic<uint32_t> mPending; /// @note Predecessors left to complete in this frame
+    std::atomic<bool> mIsParked; /// @note Ready, but the previous frame of this serial stage is still running
+    Suspension mSuspension; /// @note Awaiting a pending Completion suspends the job without holding its worker
+    uint64_t mElapsed; /// @note Execution time (ns) accumulated across suspensions
+    Loop *mLoop; /// @note Set instead of mNode for a chunk of a data-parallel loop
+    size_t mBegin;
+    size_t mEnd;
+  }; /// struct Job
+
+  ///
+  /// @brief One parallelFor() call.
+  /// @note Chunks are split off lazily: whoever runs a chunk halves it until
+  ///   it is no larger than the grain and pushes the upper halves as jobs,
+  ///   so idle workers steal large pieces first. Loop chunks run at HIGH
+  ///   priority because their caller is blocked on them.
+  ///
+  struct Loop
+  {
+    typedef void (*InvokeType)(const void *body, const size_t begin, const size_t end);
+
+    Loop() : mBody(NULL), mInvoke(NULL), mArena(NULL), mCost(NULL), mGrain(1), mPending(0), mJobs(NULL), mJobCount(0) {}
+
+    const void *mBody;
+    InvokeType mInvoke;
+    FrameArena *mArena; /// @note Arena of the caller, current wherever a chunk runs
+    std::atomic<uint64_t> *mCost; /// @note Observed cost of one iteration of this body type, in 1/256 ns
+    size_t mGrain;
+    std::atomic<uint32_t> mPending; /// @note Chunks left to complete
+    Job *mJobs; /// @note Storage for split-off chunks
+    std::atomic<uint32_t> mJobCount;
+  }; /// struct Loop
+
+  ///
+  /// @brief Reusable job storage for the parallelFor() calls of one thread.
+  /// @note Kept per nesting depth. The calls of one thread are strictly
+  ///   nested, so a level only grows once every loop that used it has
+  ///   completed, and no split-off chunk ever sees its storage move.
+  ///
+  struct LoopStorage
+  {
+    LoopStorage() : mDepth(0) {}
+    ~LoopStorage();
+    Job* push(const size_t count);
+    FORCE_INLINE void pop() { --this->mDepth; }
+
+    std::vector<Job*> mLevels;
+    std::vector<size_t> mCapacities;
+    uint32_t mDepth;
+  }; /// struct LoopStorage
+
+  struct Worker
+  {
+    Worker(const uint32_t index, const Topology::Processor &processor) : mIndex(index), mSeed(index + 1), mAcquisitions(0), mProcessor(processor), mLocalVictimCount(0) {}
+    FORCE_INLINE uint32_t random()
+    {
+      /// @note xorshift32
+      this->mSeed ^= this->mSeed << 13;
+      this->mSeed ^= this->mSeed >> 17;
+      this->mSeed ^= this->mSeed << 5;
+      return this->mSeed;
+    }
+
+    uint32_t mIndex;
+    uint32_t mSeed;
+    uint32_t mAcquisitions;
+    Topology::Processor mProcessor;
+    WorkStealingDeque<Job*> mDeques[Task::Priority::COUNT]; /// @note One deque per priority level
+    std::vector<Worker*> mVictims; /// @note Other workers, those on the same NUMA node first
+    uint32_t mLocalVictimCount;
+    LoopStorage mLoops;
+  }; /// struct Worker
+
+  NativeScheduler(const uint32_t workerCount = 0, const uint32_t affinity = Topology::Policy::NONE); /// @note Workers are pinned by the Topology::Policy and steal on their own NUMA node first
+  ~NativeScheduler();
+  bool registerTask(const TaskType::Pointer task);
+  bool unregisterTask(const TaskType::IdType taskId);
+  uint32_t registerTasks(const TaskList &tasks);
+  uint32_t unregisterTasks(const IdList &taskIds);
+  void schedule();
+  HandleType run(TaskType::InputType input = TaskType::InputType(), const bool wait = true);
+  HandleType pipeline(const uint32_t frameCount, TaskType::InputType input = TaskType::InputType(), const bool wait = true);
+  void wait();
+  bool wait(const uint64_t run, const uint64_t timeout);
+  FORCE_INLINE bool isComplete(const uint64_t run) const { return this->mRuns.isComplete(run); }
+  FORCE_INLINE void then(const uint64_t run, const RunTracker::ContinuationType continuation, void *context) { this->mRuns.then(run, continuation, context); }
+  void clear();
+  void setFramesInFlight(const uint32_t framesInFlight);
+  FORCE_INLINE uint32_t getFramesInFlight() const { return this->mFramesInFlight; }
+  FORCE_INLINE uint32_t getWorkerCount() const { return this->mWorkers.size(); }
+  FORCE_INLINE Tracer& getTracer() { return this->mTracer; }
+  FORCE_INLINE FrameBudget& getBudget() { return this->mBudget; }
+  FORCE_INLINE FrameArena& getArena(const uint32_t slot = 0) { return *this->mArenas[slot]; } /// @note run() uses slot 0
+  template <typename BODY> void parallelFor(const size_t begin, const size_t end, const BODY &body);
+
+  static const uint32_t STEAL_ATTEMPTS = 64; /// @note Failed steal rounds before a worker sleeps
+  static const uint32_t STARVATION_LIMIT = 16; /// @note Every Nth acquisition scans from LOW upwards
+  static const uint32_t CRITICAL_PATH_INTERVAL = 32; /// @note Runs between critical path updates
+  static const uint32_t DEFAULT_FRAMES_IN_FLIGHT = 2;
+  static const uint64_t LOOP_CHUNK_NANOSECONDS = 20000; /// @note Target duration of one loop chunk
+  static const uint32_t LOOP_CHUNKS_PER_WORKER = 64; /// @note Upper bound on chunks per worker, whatever the cost
+  static const uint32_t HELP_MAX_BACKOFF_MICROSECONDS = 64; /// @note Longest nap of a thread waiting on a loop with nothing to help with
+
+protected:
+  DEFINE_PROPERTY_INLINE_VOLATILE(bool, IsGraphDirty, mIsGraphDirty);
+  void updateCriticalPath();
+  void workerMain(const uint32_t index, const Topology::Processor processor);
+  bool isActive(const Node &node) const;
+  void launch(int64_t frame, Worker *worker);
+  bool start(const int64_t frame, Worker *worker);
+  int64_t retire(const int64_t frame);
+  void ready(Job *job, Worker *worker);
+  void execute(Job *job, Worker *worker);
+  Job* acquire(Worker *worker);
+  Job* acquireExternal();
+  Job* steal(const Worker *thief, const uint32_t start, const bool isAging);
+  static Job* steal(Worker * const *victims, const uint32_t count, const uint32_t start, const uint32_t level);
+  void submit(Job *job, Worker *worker);
+  static void resume(void *scheduler, void *job);
+  void runLoop(Loop &loop, const size_t begin, const size_t end);
+  void executeLoop(Job *job, Worker *worker);
+  void help(const std::atomic<uint32_t> &pending, Worker *worker);
+  Worker* getCurrentWorker() const;
+  void notify();
+  void sleep();
+  bool hasWork() const;
+  void compactInbox();
+  Job* acquireMain();
+  static uint32_t toLevel(const uint32_t step, const bool isAging);
+  template <typename BODY> static void invoke(const void *body, const size_t begin, const size_t end);
+
+  /// @note Observed iteration cost per loop body type
+  template <typename BODY> struct LoopCost
+  {
+    static std::atomic<uint64_t> VALUE;
+  }; /// struct LoopCost
+
+  static THREAD_LOCAL Worker *CURRENT_WORKER;
+  static THREAD_LOCAL LoopStorage *EXTERNAL_LOOPS; /// @note Claimed by a thread outside the pool for its outermost loop
+
+  volatile bool mIsGraphDirty;
+  std::atomic<bool> mIsShutdown;
+  TaskType::InputType mInput;
+  TaskList mTasks;
+  boost::mutex mTaskMutex;
+  boost::scoped_array<Node> mNodes; /// @note Only grows, so graphs no larger than the largest seen do not allocate
+  uint32_t mNodeCount;
+  uint32_t mNodeCapacity;
+  uint32_t mRunCount;
+  uint32_t_v mRoots;
+  uint32_t_v mRecurringRoots; /// @note Recurring tasks without recurring predecessors
+  uint32_t mRecurringCount;
+  uint32_t_v mOrder; /// @note Scratch space for updateCriticalPath()
+  uint32_t_v mPending; /// @note Scratch space for updateCriticalPath()
+  uint32_t mFramesInFlight;
+  boost::scoped_array<Job> mJobs; /// @note [Node index * frames in flight + slot]
+  uint32_t mJobCapacity;
+  boost::scoped_array<std::atomic<uint32_t> > mSlotOutstanding; /// @note Jobs left to complete per frame slot
+  boost::scoped_array<uint64_t> mSlotStart; /// @note Start time (us) of the frame each slot holds
+  uint32_t mSlotCapacity;
+  bool mIsPipelined;
+  int64_t mFrameCount;
+  std::vector<Worker*> mWorkers;
+  std::vector<boost::thread*> mThreads;
+  boost::scoped_ptr<boost::barrier> mStartup; /// @note Held until the workers have exited
+  std::vector<Job*> mInbox; /// @note Consumed from mInboxHead; storage is reused once drained
+  size_t mInboxHead;
+  boost::mutex mInboxMutex;
+  std::atomic<uint32_t> mInboxSize;
+  boost::mutex mSleepMutex;
+  boost::condition_variable mSleepCondition;
+  std::atomic<uint32_t> mSleeping;
+  std::atomic<uint32_t> mStealCursor; /// @note Victim rotation for threads outside the pool
+  LoopStorage mExternalLoops; /// @note Loop storage for one thread outside the pool at a time
+  std::atomic<bool> mIsExternalLoopBusy;
+  std::atomic<uint32_t> mOutstanding; /// @note Frames left to complete in the current run
+  boost::mutex mDoneMutex;
+  boost::condition_variable mDoneCondition; /// @note Also signalled when a main-thread task becomes ready
+  std::vector<Job*> mMainQueue; /// @note Ready main-thread tasks; guarded by mDoneMutex
+  RunTracker mRuns;
+  std::vector<SharedPointer<FrameArena> > mArenas; /// @note [Frame slot]; reset as the frame in the slot retires. One lane per worker and one for the waiting thread
+  Tracer mTracer;
+  FrameBudget mBudget; /// @note LOW-priority recurring tasks whose frame is at risk of overrunning it are shed
+}; /// class NativeScheduler
+
+///
+/// Includes
+///
+
+#include "concurrency/native/NativeScheduler-inl.h"
+
+} /// namespace Impl
+} /// namespace Concurrency
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_CORE_CONCURRENCY_IMPL_NATIVESCHEDULER_H
@@ -0,0 +1,67 @@
+///
+/// @file NativeTraits.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by The Secret Design Collective
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+///     this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+///     this list of conditions and the following disclaimer in the documentation
+///     and/or other materials provided with the distribution.
+///    * Neither the name of The Secret Design Collective nor the names of its
+///     contributors may be used to endorse or promote products derived from
+///     this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+#ifndef RSSD_CORE_CONCURRENCY_IMPL_NATIVETRAITS_H
+#define RSSD_CORE_CONCURRENCY_IMPL_NATIVETRAITS_H
+
+#include "System"
+#include "concurrency/Task.h"
+#include "concurrency/Frame.h"
+
+namespace RSSD {
+namespace Core {
+namespace Concurrency {
+namespace Impl {
+
+struct NativeTraits
+{
+  typedef uint32_t IdType;
+  typedef Frame InputType; /// @note Typed results travel through Ports indexed by the frame
+  typedef void OutputType;
+  typedef BaseTask<NativeTraits> TaskType;
+
+  static IdType generateTaskId()
+  {
+    static const IdType INITIAL_VALUE = 1;
+    static const IdType STEP_SIZE = 1;
+    static std::atomic<IdType> COUNTER(INITIAL_VALUE);
+
+    return COUNTER.fetch_add(STEP_SIZE);
+  }
+}; /// struct NativeTraits
+
+} /// namespace Impl
+} /// namespace Concurrency
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_CORE_CONCURRENCY_IMPL_NATIVETRAITS_H
@@ -0,0 +1,247 @@
+#include <cstdio>
+#include <fstream>
+#include "concurrency/native/Topology.h"
+
+#if RSSD_PLATFORM_LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace RSSD;
+using namespace RSSD::Core;
+using namespace RSSD::Core::Concurrency;
+using namespace RSSD::Core::Concurrency::Impl;
+
+namespace {
+
+const uint32_t MAX_PROCESSORS = 4096;
+const uint32_t MAX_NODES = 1024;
+
+/// @note Siblings on the same core, cores on the same node, then nodes
+struct CompactCompare
+{
+  bool operator()(const Topology::Processor &lhs, const Topology::Processor &rhs) const
+  {
+    if (lhs.mNode != rhs.mNode) { return (lhs.mNode < rhs.mNode); }
+    if (lhs.mPackage != rhs.mPackage) { return (lhs.mPackage < rhs.mPackage); }
+    if (lhs.mCore != rhs.mCore) { return (lhs.mCore < rhs.mCore); }
+    if (lhs.mThread != rhs.mThread) { return (lhs.mThread < rhs.mThread); }
+    return (lhs.mIndex < rhs.mIndex);
+  }
+}; /// struct CompactCompare
+
+/// @note One core per node in turn; hyperthread siblings after all cores
+struct ScatterCompare
+{
+  ScatterCompare(const uint32_t_v &ranks) : mRanks(ranks) {}
+  bool operator()(const Topology::Processor &lhs, const Topology::Processor &rhs) const
+  {
+    if (lhs.mThread != rhs.mThread) { return (lhs.mThread < rhs.mThread); }
+    const uint32_t x = this->mRanks[lhs.mIndex], y = this->mRanks[rhs.mIndex];
+    if (x != y) { return (x < y); }
+    if (lhs.mNode != rhs.mNode) { return (lhs.mNode < rhs.mNode); }
+    return (lhs.mIndex < rhs.mIndex);
+  }
+
+  const uint32_t_v &mRanks; /// @note [Processor index] => rank of its core within its node
+}; /// struct ScatterCompare
+
+} /// namespace
+
+///
+/// @class Topology
+///
+
+Topology::Topology() :
+  mNodeCount(1)
+{
+  if (this->detect()) { return; }
+
+  /// Flat fallback
+  uint32_t count = boost::thread::hardware_concurrency();
+  if (!count) { count = 1; }
+  this->mProcessors.resize(count);
+  for (uint32_t index = 0; index < count; ++index)
+  {
+    this->mProcessors[index].mIndex = index;
+    this->mProcessors[index].mCore = index;
+  }
+  this->mNodeCount = 1;
+}
+
+///
+/// @note Returns one processor per worker. With count 0, returns one per
+///   processor the policy would use. Larger counts wrap around, so some
+///   processors run more than one worker. Policy::NONE returns unpinned
+///   entries on node 0.
+///
+Topology::ProcessorList Topology::place(const uint32_t policy, const uint32_t count) const
+{
+  /// Local vars
+  ProcessorList candidates;
+
+  switch (policy)
+  {
+  case Topology::Policy::COMPACT:
+  {
+    candidates = this->mProcessors;
+    std::sort(candidates.begin(), candidates.end(), CompactCompare());
+    break;
+  }
+
+  case Topology::Policy::SCATTER:
+  {
+    /// Rank each core within its node, in compact order
+    candidates = this->mProcessors;
+    std::sort(candidates.begin(), candidates.end(), CompactCompare());
+    uint32_t_v ranks;
+    uint32_t rank = 0;
+    for (uint32_t index = 0; index < candidates.size(); ++index)
+    {
+      const Processor &processor = candidates[index];
+      if (index && (processor.mNode != candidates[index - 1].mNode)) { rank = 0; }
+      else if (index && ((processor.mPackage != candidates[index - 1].mPackage) || (processor.mCore != candidates[index - 1].mCore))) { ++rank; }
+      if (static_cast<uint32_t>(processor.mIndex) >= ranks.size()) { ranks.resize(processor.mIndex + 1, 0); }
+      ranks[processor.mIndex] = rank;
+    }
+    std::sort(candidates.begin(), candidates.end(), ScatterCompare(ranks));
+    break;
+  }
+
+  case Topology::Policy::PHYSICAL:
+  {
+    ProcessorList::const_iterator
+      iter = this->mProcessors.begin(),
+      end = this->mProcessors.end();
+    for (; iter != end; ++iter)
+    {
+      if (!iter->mThread) { candidates.push_back(*iter); }
+    }
+    std::sort(candidates.begin(), candidates.end(), CompactCompare());
+    break;
+  }
+
+  default:
+  {
+    candidates.resize(this->mProcessors.size());
+    break;
+  }
+  }
+
+  if (candidates.empty()) { candidates.resize(1); }
+  ProcessorList placement(count ? count : candidates.size());
+  for (uint32_t index = 0; index < placement.size(); ++index)
+  {
+    placement[index] = candidates[index % candidates.size()];
+  }
+  return placement;
+}
+
+///
+/// @note Binds the calling thread to the given processor.
+///
+bool Topology::pin(const Topology::Processor &processor)
+{
+  if (processor.mIndex < 0) { return false; }
+
+#if RSSD_PLATFORM_LINUX
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(processor.mIndex, &set);
+  return (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0);
+#else
+  return false;
+#endif
+}
+
+bool Topology::detect()
+{
+#if RSSD_PLATFORM_LINUX
+  /// Local vars
+  char path[128];
+  std::map<std::pair<uint32_t, uint32_t>, uint32_t> threads; /// @note [(Package, core)] => hardware threads seen
+  uint32_t_v online;
+
+  if (!Topology::readList("/sys/devices/system/cpu/online", online) || online.empty()) { return false; }
+
+  /// Processors
+  uint32_t_v::const_iterator
+    iter = online.begin(),
+    end = online.end();
+  for (; iter != end; ++iter)
+  {
+    Processor processor;
+    processor.mIndex = *iter;
+    std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/core_id", *iter);
+    Topology::readInteger(path, processor.mCore);
+    std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/physical_package_id", *iter);
+    Topology::readInteger(path, processor.mPackage);
+    processor.mThread = threads[std::make_pair(processor.mPackage, processor.mCore)]++;
+    this->mProcessors.push_back(processor);
+  }
+
+  /// NUMA nodes; absent on kernels built without NUMA support
+  std::map<uint32_t, uint32_t> nodes; /// @note [Processor index] => node
+  uint32_t nodeCount = 0;
+  for (uint32_t node = 0; node < MAX_NODES; ++node)
+  {
+    uint32_t_v processors;
+    std::snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist", node);
+    if (!Topology::readList(path, processors)) { continue; }
+    ++nodeCount;
+    for (iter = processors.begin(), end = processors.end(); iter != end; ++iter)
+    {
+      nodes[*iter] = node;
+    }
+  }
+
+  ProcessorList::iterator
+    processorIter = this->mProcessors.begin(),
+    processorEnd = this->mProcessors.end();
+  for (; processorIter != processorEnd; ++processorIter)
+  {
+    std::map<uint32_t, uint32_t>::const_iterator node = nodes.find(processorIter->mIndex);
+    processorIter->mNode = (node != nodes.end()) ? node->second : 0;
+  }
+  this->mNodeCount = std::max<uint32_t>(1, nodeCount);
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool Topology::readInteger(const std::string &path, uint32_t &value)
+{
+  std::ifstream file(path.c_str());
+  file >> value;
+  return !file.fail();
+}
+
+///
+/// @note Parses the kernel's list format, e.g. "0-3,8-11".
+///
+bool Topology::readList(const std::string &path, uint32_t_v &values)
+{
+  /// Local vars
+  std::ifstream file(path.c_str());
+  std::string text;
+
+  if (!(file >> text)) { return false; }
+  std::vector<std::string> ranges;
+  boost::algorithm::split(ranges, text, boost::algorithm::is_any_of(","));
+  std::vector<std::string>::const_iterator
+    iter = ranges.begin(),
+    end = ranges.end();
+  for (; iter != end; ++iter)
+  {
+    uint32_t first = 0, last = 0;
+    const int fields = std::sscanf(iter->c_str(), "%u-%u", &first, &last);
+    if (fields < 1) { continue; }
+    if (fields < 2) { last = first; }
+    for (uint32_t value = first; (value <= last) && (value < MAX_PROCESSORS); ++value)
+    {
+      values.push_back(value);
+    }
+  }
+  return true;
+}
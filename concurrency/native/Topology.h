@@ -0,0 +1,98 @@
+///
+/// @file Topology.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by The Secret Design Collective
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+///     this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+///     this list of conditions and the following disclaimer in the documentation
+///     and/or other materials provided with the distribution.
+///    * Neither the name of The Secret Design Collective nor the names of its
+///     contributors may be used to endorse or promote products derived from
+///     this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+
+#ifndef RSSD_CORE_CONCURRENCY_IMPL_TOPOLOGY_H
+#define RSSD_CORE_CONCURRENCY_IMPL_TOPOLOGY_H
+
+#include "System"
+
+namespace RSSD {
+namespace Core {
+namespace Concurrency {
+namespace Impl {
+
+///
+/// @brief Processor layout of the host and placement of worker threads on it.
+/// @note On Linux the layout is read from sysfs. Elsewhere, or if sysfs is
+///   unavailable, every hardware thread is reported as its own core on
+///   NUMA node 0 and pin() does nothing.
+///
+class Topology
+{
+public:
+  struct Policy
+  {
+    enum
+    {
+      NONE = 0, /// @note Workers float; the OS places them
+      COMPACT, /// @note Fill one NUMA node, including hyperthread siblings, before the next
+      SCATTER, /// @note Spread across NUMA nodes and cores; hyperthread siblings last
+      PHYSICAL, /// @note One worker per physical core, leaving hyperthread siblings unused
+      COUNT
+    };
+  };
+
+  struct Processor
+  {
+    Processor() : mIndex(-1), mCore(0), mPackage(0), mNode(0), mThread(0) {}
+
+    int32_t mIndex; /// @note OS processor number; -1 when not pinned
+    uint32_t mCore; /// @note Core ID within the package
+    uint32_t mPackage;
+    uint32_t mNode; /// @note NUMA node
+    uint32_t mThread; /// @note Position among the hardware threads of the same core
+  }; /// struct Processor
+
+  typedef std::vector<Processor> ProcessorList;
+
+  Topology();
+  FORCE_INLINE const ProcessorList& getProcessors() const { return this->mProcessors; }
+  FORCE_INLINE uint32_t getNodeCount() const { return this->mNodeCount; }
+  ProcessorList place(const uint32_t policy, const uint32_t count = 0) const;
+  static bool pin(const Processor &processor);
+
+protected:
+  bool detect();
+  static bool readInteger(const std::string &path, uint32_t &value);
+  static bool readList(const std::string &path, uint32_t_v &values);
+
+  ProcessorList mProcessors;
+  uint32_t mNodeCount;
+}; /// class Topology
+
+} /// namespace Impl
+} /// namespace Concurrency
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_CORE_CONCURRENCY_IMPL_TOPOLOGY_H
@@ -0,0 +1,131 @@
+///
+/// @class WorkStealingDeque<>::Array
+///
+
+template <typename ITEM>
+WorkStealingDeque<ITEM>::Array::Array(const int64_t capacity) :
+  mCapacity(capacity),
+  mMask(capacity - 1),
+  mItems(new std::atomic<Item>[capacity])
+{
+  assert (((capacity & (capacity - 1)) == 0) && "Deque capacity must be a power of two.");
+}
+
+template <typename ITEM>
+WorkStealingDeque<ITEM>::Array::~Array()
+{
+  delete [] this->mItems;
+}
+
+template <typename ITEM>
+typename WorkStealingDeque<ITEM>::Array* WorkStealingDeque<ITEM>::Array::grow(
+  const int64_t bottom,
+  const int64_t top) const
+{
+  Array *array = new Array(this->mCapacity * 2);
+  for (int64_t index = top; index < bottom; ++index)
+  {
+    array->put(index, this->get(index));
+  }
+  return array;
+}
+
+///
+/// @class WorkStealingDeque<>
+///
+
+template <typename ITEM>
+WorkStealingDeque<ITEM>::WorkStealingDeque(const uint32_t capacity) :
+  mTop(0),
+  mBottom(0),
+  mArray(new Array(capacity))
+{
+}
+
+template <typename ITEM>
+WorkStealingDeque<ITEM>::~WorkStealingDeque()
+{
+  delete this->mArray.load(std::memory_order_relaxed);
+  typename std::vector<Array*>::iterator
+    iter = this->mRetired.begin(),
+    end = this->mRetired.end();
+  for (; iter != end; ++iter)
+  {
+    delete *iter;
+  }
+}
+
+template <typename ITEM>
+void WorkStealingDeque<ITEM>::push(Item item)
+{
+  const int64_t bottom = this->mBottom.load(std::memory_order_relaxed);
+  const int64_t top = this->mTop.load(std::memory_order_acquire);
+  Array *array = this->mArray.load(std::memory_order_relaxed);
+
+  /// Grow the circular buffer when full
+  if ((bottom - top) > (array->mCapacity - 1))
+  {
+    this->mRetired.push_back(array);
+    array = array->grow(bottom, top);
+    this->mArray.store(array, std::memory_order_release);
+  }
+
+  array->put(bottom, item);
+  std::atomic_thread_fence(std::memory_order_release);
+  this->mBottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+template <typename ITEM>
+bool WorkStealingDeque<ITEM>::pop(Item &item)
+{
+  const int64_t bottom = this->mBottom.load(std::memory_order_relaxed) - 1;
+  Array *array = this->mArray.load(std::memory_order_relaxed);
+  this->mBottom.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t top = this->mTop.load(std::memory_order_relaxed);
+
+  /// Deque was empty
+  if (top > bottom)
+  {
+    this->mBottom.store(bottom + 1, std::memory_order_relaxed);
+    return false;
+  }
+
+  /// More than one item left; no race with thieves
+  item = array->get(bottom);
+  if (top < bottom) { return true; }
+
+  /// Last item; race thieves for it
+  const bool result = this->mTop.compare_exchange_strong(
+    top,
+    top + 1,
+    std::memory_order_seq_cst,
+    std::memory_order_relaxed);
+  this->mBottom.store(bottom + 1, std::memory_order_relaxed);
+  return result;
+}
+
+template <typename ITEM>
+bool WorkStealingDeque<ITEM>::steal(Item &item)
+{
+  int64_t top = this->mTop.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const int64_t bottom = this->mBottom.load(std::memory_order_acquire);
+  if (top >= bottom) { return false; }
+
+  Array *array = this->mArray.load(std::memory_order_acquire);
+  item = array->get(top);
+  return this->mTop.compare_exchange_strong(
+    top,
+    top + 1,
+    std::memory_order_seq_cst,
+    std::memory_order_relaxed);
+}
+
+template <typename ITEM>
+int64_t WorkStealingDeque<ITEM>::size() const
+{
+  const int64_t bottom = this->mBottom.load(std::memory_order_relaxed);
+  const int64_t top = this->mTop.load(std::memory_order_relaxed);
+  return (bottom - top);
+}
@@ -0,0 +1,100 @@
+///
+/// @file WorkStealingDeque.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by The Secret Design Collective
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+///     this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+///     this list of conditions and the following disclaimer in the documentation
+///     and/or other materials provided with the distribution.
+///    * Neither the name of The Secret Design Collective nor the names of its
+///     contributors may be used to endorse or promote products derived from
+///     this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+#ifndef RSSD_CORE_CONCURRENCY_IMPL_WORKSTEALINGDEQUE_H
+#define RSSD_CORE_CONCURRENCY_IMPL_WORKSTEALINGDEQUE_H
+
+#include "System"
+
+namespace RSSD {
+namespace Core {
+namespace Concurrency {
+namespace Impl {
+
+///
+/// @brief Lock-free, growable Chase-Lev work-stealing deque.
+/// @note Only the owning worker may push() and pop() (LIFO end);
+///   any other thread may steal() from the opposite (FIFO) end.
+/// @note ITEM must be trivially copyable, e.g. a pointer.
+/// @ref D. Chase and Y. Lev, "Dynamic Circular Work-Stealing Deque", SPAA 2005.
+/// @ref N. M. Le et al., "Correct and Efficient Work-Stealing for Weak
+///   Memory Models", PPoPP 2013.
+///
+template <typename ITEM>
+class WorkStealingDeque : public boost::noncopyable
+{
+public:
+  typedef ITEM Item;
+
+  WorkStealingDeque(const uint32_t capacity = DEFAULT_CAPACITY);
+  ~WorkStealingDeque();
+  void push(Item item);
+  bool pop(Item &item);
+  bool steal(Item &item);
+  int64_t size() const;
+  FORCE_INLINE bool empty() const { return (this->size() <= 0); }
+
+  static const uint32_t DEFAULT_CAPACITY = 256;
+
+protected:
+  struct Array
+  {
+    Array(const int64_t capacity);
+    ~Array();
+    FORCE_INLINE Item get(const int64_t index) const { return this->mItems[index & this->mMask].load(std::memory_order_relaxed); }
+    FORCE_INLINE void put(const int64_t index, Item item) { this->mItems[index & this->mMask].store(item, std::memory_order_relaxed); }
+    Array* grow(const int64_t bottom, const int64_t top) const;
+
+    int64_t mCapacity;
+    int64_t mMask;
+    std::atomic<Item> *mItems;
+  }; /// struct Array
+
+  std::atomic<int64_t> mTop;
+  char mPadding[64 - sizeof(std::atomic<int64_t>)]; /// @note Keep owner and thief indices on separate cache lines.
+  std::atomic<int64_t> mBottom;
+  std::atomic<Array*> mArray;
+  std::vector<Array*> mRetired; /// @note Thieves may still read a replaced array; free on destruction only.
+}; /// class WorkStealingDeque
+
+///
+/// Includes
+///
+
+#include "concurrency/native/WorkStealingDeque-inl.h"
+
+} /// namespace Impl
+} /// namespace Concurrency
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_CORE_CONCURRENCY_IMPL_WORKSTEALINGDEQUE_H
@@ -0,0 +1,16 @@
+///
+/// @class TbbScheduler
+///
+
+///
+/// @note Calls body(chunkBegin, chunkEnd) over disjoint chunks covering
+///   [begin, end). The auto_partitioner sizes chunks from the observed
+///   stealing, and the calling thread joins in while it waits, so calls may
+///   nest inside tasks.
+///
+template <typename BODY>
+void TbbScheduler::parallelFor(const size_t begin, const size_t end, const BODY &body)
+{
+  if (end <= begin) { return; }
+  tbb::parallel_for(tbb::blocked_range<size_t>(begin, end), RangeBody<BODY>(body), tbb::auto_partitioner());
+}
@@ -10,123 +10,1009 @@ using namespace RSSD::Core::Concurrency::Impl;
 ///
 
 TbbScheduler::TbbScheduler() :
-  mIsGraphDirty(false)
+  mIsGraphDirty(false),
+  mLongestPath(0),
+  mRunCount(0),
+  mRunStart(0),
+  mFramesInFlight(TbbScheduler::DEFAULT_FRAMES_IN_FLIGHT),
+  mFrameSink(mBudget, mArenas, mFrameSource)
 {
+  this->mArenas.push_back(SharedPointer<FrameArena>(new FrameArena(tbb::task_scheduler_init::default_num_threads() + 1)));
+  this->mSequence = 0;
+  this->mRunRemaining = 0;
+  this->mResumeCount = 0;
 
 }
 
 TbbScheduler::~TbbScheduler()
 {
   this->clear();
+  this->mContinuationGroup.wait();
 }
 
+///
+/// @note Graph changes are queued and applied by the next schedule(),
+///   in the order they were made, so registration is safe while the graph
+///   is running. The registry is updated at once, so registering a task
+///   twice fails even before schedule() has run.
+///
 bool TbbScheduler::registerTask(const TbbScheduler::TaskType::Pointer task)
 {
-  /// Local vars
-  bool result = true;
-  TaskMap::accessor taskAccessor;
-  TaskDependencyMap::accessor dependAccessor;
+  if (!task) { return false; }
+  boost::mutex::scoped_lock lock(this->mRegistryMutex);
+  if (!this->mRegistry.insert(task->getTaskId(), task).isValid()) { return false; }
+  const Operation operation = { task, task->getTaskId() };
+  this->mOperations.push_back(operation);
 
-  /// Add to task collection
-  assert (this->mTasks.insert(taskAccessor, task->getType()));
-  taskAccessor->second = task;
+  /// Update graph dirty flag
+  this->setIsGraphDirty(true);
+  return true;
+}
 
-  /// Add task as a parent to dependency collection
-  assert (this->mDependencies.insert(dependAccessor, task->getType()));
-  dependAccessor->second = TaskMap();
+bool TbbScheduler::unregisterTask(const TbbScheduler::TaskType::IdType taskId)
+{
+  boost::mutex::scoped_lock lock(this->mRegistryMutex);
+  if (!this->mRegistry.erase(taskId)) { return false; }
+  const Operation operation = { TaskType::Pointer(), taskId };
+  this->mOperations.push_back(operation);
 
-  /// Add to task as a child (dependent) to dependents collection (optional)
-  if (task->getDependency())
+  /// Update graph dirty flag
+  this->setIsGraphDirty(true);
+  return true;
+}
+
+///
+/// @note Queues the whole batch and marks the graph dirty once; the next
+///   schedule() applies it in one pass. Returns the number of tasks queued;
+///   tasks already registered are skipped.
+///
+uint32_t TbbScheduler::registerTasks(const TbbScheduler::TaskList &tasks)
+{
+  /// Local vars
+  uint32_t queued = 0;
+
+  boost::mutex::scoped_lock lock(this->mRegistryMutex);
+  TaskList::const_iterator
+    iter = tasks.begin(),
+    end = tasks.end();
+  for (; iter != end; ++iter)
   {
-    this->mDependencies.insert(dependAccessor, task->getDependency());
-    TaskMap &taskMap = dependAccessor->second;
-    if (taskMap.insert(taskAccessor, task->getType())) { taskAccessor->second = task; }
+    if (!*iter || !this->mRegistry.insert((*iter)->getTaskId(), *iter).isValid()) { continue; }
+    const Operation operation = { *iter, (*iter)->getTaskId() };
+    this->mOperations.push_back(operation);
+    ++queued;
   }
+  if (!queued) { return 0; }
 
   /// Update graph dirty flag
   this->setIsGraphDirty(true);
-  return result;
+  return queued;
 }
 
-bool TbbScheduler::unregisterTask(const TbbScheduler::TaskType::IdType taskType)
+uint32_t TbbScheduler::unregisterTasks(const TbbScheduler::IdList &taskIds)
 {
   /// Local vars
-  TaskMap::accessor taskAccessor;
-  TaskMap::accessor eraseTaskAccessor;
-  TaskDependencyMap::accessor dependAccessor;
-
-  /// Remove from task collection
-  if (!this->mTasks.find(taskAccessor, taskType)) { return false; }
-  TaskType::Pointer task(taskAccessor->second);
+  uint32_t queued = 0;
 
-  /// Remove from task dependents collection (optional)
-  if (task->getDependency())
+  boost::mutex::scoped_lock lock(this->mRegistryMutex);
+  IdList::const_iterator
+    iter = taskIds.begin(),
+    end = taskIds.end();
+  for (; iter != end; ++iter)
   {
-    if (!this->mDependencies.find(dependAccessor, task->getDependency())) { return false; }
-    TaskMap &taskMap = dependAccessor->second;
-    if (!taskMap.find(eraseTaskAccessor, task->getType())) { return false; }
-    if (!taskMap.erase(eraseTaskAccessor)) { return false; }
+    if (!this->mRegistry.erase(*iter)) { continue; }
+    const Operation operation = { TaskType::Pointer(), *iter };
+    this->mOperations.push_back(operation);
+    ++queued;
   }
+  if (!queued) { return 0; }
 
   /// Update graph dirty flag
   this->setIsGraphDirty(true);
-  return true;
+  return queued;
 }
 
 void TbbScheduler::schedule()
+{
+  /// Update graph dirty flag first so that changes queued meanwhile are kept
+  this->setIsGraphDirty(false);
+  {
+    boost::mutex::scoped_lock lock(this->mRegistryMutex);
+    if (this->mOperations.empty()) { return; }
+    this->mApplying.swap(this->mOperations);
+  }
+
+  /// Edges must not change under a running graph
+  this->wait();
+
+  /// Apply only the queued changes to the persistent graph
+  this->apply(this->mApplying);
+  this->mApplying.clear();
+  this->updateCriticalPath();
+  this->compile();
+}
+
+TbbScheduler::HandleType TbbScheduler::run(TaskType::InputType input, const bool wait)
+{
+  /// Only one run of the graph may be in flight
+  this->wait();
+  if (this->getIsGraphDirty()) { this->schedule(); }
+  if (!this->mPlan.mIsValid) { this->compile(); }
+  if (this->mPlan.mHandles.empty()) { return HandleType(); }
+  if ((++this->mRunCount % TbbScheduler::CRITICAL_PATH_INTERVAL) == 0) { this->updateCriticalPath(); }
+
+  /// Re-arm the compiled plan
+  const uint32_t count = this->mPlan.mHandles.size();
+  for (uint32_t position = 0; position < count; ++position)
+  {
+    this->mPlan.mPending[position] = this->mPlan.mPredecessorCounts[position];
+  }
+  this->mInput = input;
+  this->mRunStart = FrameBudget::now();
+  this->mRunRemaining = count;
+  const HandleType handle(this, this->mRuns.begin());
+
+  /// Queue the whole first level before any of it runs; every later task is
+  /// queued by its last predecessor
+  const uint32_t roots = this->mPlan.mLevels[1];
+  for (uint32_t position = 0; position < roots; ++position)
+  {
+    this->mReady.push(this->rank(position));
+  }
+  this->spawn(roots);
+  if (wait) { this->wait(); }
+  return handle;
+}
+
+///
+/// @note Runs the recurring tasks frameCount times through a tbb::pipeline
+///   with up to FramesInFlight frames live at once. Each topological level
+///   of the recurring tasks is one stage, so a frame only enters a level
+///   once it has left the previous one. Frame numbers continue from
+///   input.mIndex. Stages run on pipeline threads, so main-thread tasks
+///   are only kept on the waiting thread by run().
+///   A stage cannot return before its frame is done, so a stage task
+///   that awaits a pending Completion blocks its thread.
+///
+TbbScheduler::HandleType TbbScheduler::pipeline(const uint32_t frameCount, TaskType::InputType input, const bool wait)
+{
+  this->wait();
+  if (this->getIsGraphDirty()) { this->schedule(); }
+  if (!frameCount) { return HandleType(); }
+  if ((++this->mRunCount % TbbScheduler::CRITICAL_PATH_INTERVAL) == 0) { this->updateCriticalPath(); }
+
+  if (!this->mPlan.mIsValid) { this->compile(); }
+  if (this->mStages.empty()) { return HandleType(); }
+  this->mFrameSource.reset(input, frameCount, this->mFramesInFlight);
+  while (this->mArenas.size() < this->mFramesInFlight)
+  {
+    this->mArenas.push_back(SharedPointer<FrameArena>(new FrameArena(tbb::task_scheduler_init::default_num_threads() + 1)));
+  }
+
+  /// Each frame slot remembers the inputs its tasks last ran on
+  std::vector<SharedPointer<StageFilter> >::const_iterator
+    stageIter = this->mStages.begin(),
+    stageEnd = this->mStages.end();
+  for (; stageIter != stageEnd; ++stageIter)
+  {
+    std::vector<NodeMap::Handle>::const_iterator
+      handleIter = (*stageIter)->mHandles.begin(),
+      handleEnd = (*stageIter)->mHandles.end();
+    for (; handleIter != handleEnd; ++handleIter)
+    {
+      TbbScheduler::resolve(this->mNodes, *handleIter).mTask->setInputSlots(this->mFramesInFlight);
+    }
+  }
+  const HandleType handle(this, this->mRuns.begin());
+
+  if (!wait)
+  {
+    this->mPipelineGroup.run(std::tr1::bind(&TbbScheduler::runPipeline, this));
+    return handle;
+  }
+  this->runPipeline();
+  return handle;
+}
+
+///
+/// @note The waiting thread takes part in the run through its task_group.
+///   Main-thread tasks are queued rather than executed by dispatch(), so
+///   the group settles with them still pending; they are then run here
+///   and release their successors, until the group settles with none left.
+///   The group also settles while tasks are suspended on a Completion;
+///   the thread then sleeps until one of them is resumed into the group.
+///
+void TbbScheduler::wait()
+{
+  /// Local vars
+  Node *node = NULL;
+
+  this->mPipelineGroup.wait();
+  while (true)
+  {
+    const uint32_t resumes = this->mResumeCount;
+    this->mRunGroup.wait();
+    if (this->mMainQueue.try_pop(node))
+    {
+      this->execute(*node);
+      continue;
+    }
+    if (!this->mRunRemaining) { break; }
+
+    /// Only suspended tasks are left
+    boost::mutex::scoped_lock lock(this->mDoneMutex);
+    if ((this->mResumeCount == resumes) && this->mMainQueue.empty() && this->mRunRemaining)
+    {
+      this->mDoneCondition.wait(lock);
+    }
+  }
+}
+
+///
+/// @note Waits like wait() without a timeout. With a timeout, the calling
+///   thread only runs main-thread tasks and leaves the rest of the graph
+///   to the TBB workers. Returns false if the run has not completed within
+///   timeout microseconds, measured on the monotonic timer clock.
+///
+bool TbbScheduler::wait(const uint64_t run, const uint64_t timeout)
 {
   /// Local vars
-  TaskMap::accessor taskAccessor;
-  TaskDependencyMap::iterator
-    dependencyIter = this->mDependencies.begin(),
-    dependencyEnd = this->mDependencies.end();
-  TaskMap::iterator taskIter, taskEnd;
+  Node *node = NULL;
+  uint64_t now = 0;
 
-  /// For each task with registered dependency(s)...
+  if (timeout == RunTracker::INFINITE)
+  {
+    if (!this->isComplete(run)) { this->wait(); }
+    return true;
+  }
+
+  const uint64_t deadline = Utilities::BasicTimer::now() + timeout * Utilities::Timer::NSEC_PER_USEC;
+  while (!this->isComplete(run))
+  {
+    now = Utilities::BasicTimer::now();
+    if (now >= deadline) { return false; }
+    if (this->mMainQueue.try_pop(node))
+    {
+      this->execute(*node);
+      continue;
+    }
+
+    boost::mutex::scoped_lock lock(this->mDoneMutex);
+    if (!this->mMainQueue.empty() || this->isComplete(run)) { continue; }
+    this->mDoneCondition.timed_wait(lock, boost::posix_time::microseconds((deadline - now) / Utilities::Timer::NSEC_PER_USEC + 1));
+  }
+  return true;
+}
+
+void TbbScheduler::clear()
+{
+  this->wait();
+  this->mPipeline.clear();
+  this->mStages.clear();
+  {
+    boost::mutex::scoped_lock lock(this->mRegistryMutex);
+    this->mRegistry.clear();
+    this->mOperations.clear();
+  }
+  this->mNodes.clear();
+  this->mDependents.clear();
+  this->mPlan.mHandles.clear();
+  this->mPlan.mIsValid = false;
+  this->setIsGraphDirty(false);
+}
+
+///
+/// @note Applies the operations in order, each run of consecutive inserts
+///   or removals as one batch, so a task registered and then unregistered
+///   before schedule() is never left in the graph.
+///
+void TbbScheduler::apply(TbbScheduler::OperationList &operations)
+{
+  OperationList::const_iterator
+    iter = operations.begin(),
+    end = operations.end();
+  for (; iter != end; ++iter)
+  {
+    if (iter->mTask)
+    {
+      if (!this->mRemovalBatch.empty()) { this->removeNodes(this->mRemovalBatch); }
+      this->mRemovalBatch.clear();
+      this->mInsertBatch.push_back(iter->mTask);
+      continue;
+    }
+    if (!this->mInsertBatch.empty()) { this->insertNodes(this->mInsertBatch); }
+    this->mInsertBatch.clear();
+    this->mRemovalBatch.push_back(iter->mTaskId);
+  }
+  if (!this->mRemovalBatch.empty()) { this->removeNodes(this->mRemovalBatch); }
+  if (!this->mInsertBatch.empty()) { this->insertNodes(this->mInsertBatch); }
+  this->mRemovalBatch.clear();
+  this->mInsertBatch.clear();
+}
+
+///
+/// @note Nodes of the whole batch are created before any edge is made, so
+///   a task registered together with its dependencies is linked to them
+///   regardless of their order in the batch.
+///
+void TbbScheduler::insertNodes(const TbbScheduler::TaskList &tasks)
+{
+  /// Local vars
+  IdList inserted;
+
+  /// Create persistent nodes
+  inserted.reserve(tasks.size());
+  this->mNodes.reserve(this->mNodes.size() + tasks.size());
+  TaskList::const_iterator
+    taskIter = tasks.begin(),
+    taskEnd = tasks.end();
+  for (; taskIter != taskEnd; ++taskIter)
+  {
+    const TaskType::IdType taskId = (*taskIter)->getTaskId();
+    const NodeMap::Handle handle = this->mNodes.insert(taskId);
+    if (!handle.isValid()) { continue; }
+    Node &node = *this->mNodes.find(handle);
+    node.mTask = *taskIter;
+    inserted.push_back(taskId);
+  }
+
+  /// Join on every registered dependency
+  IdList::const_iterator
+    iter = inserted.begin(),
+    end = inserted.end();
+  for (; iter != end; ++iter)
+  {
+    Node &node = *this->mNodes.find(*iter);
+    const TaskType::DependencyList &dependencies = node.mTask->getDependencies();
+    TaskType::DependencyList::const_iterator
+      dependencyIter = dependencies.begin(),
+      dependencyEnd = dependencies.end();
+    for (; dependencyIter != dependencyEnd; ++dependencyIter)
+    {
+      this->addDependent(*dependencyIter, *iter);
+      if (this->mNodes.contains(*dependencyIter)) { this->link(node, *dependencyIter); }
+    }
+  }
+
+  /// Join dependents that were registered before this batch
+  for (iter = inserted.begin(); iter != end; ++iter)
+  {
+    const TaskType::DependencyList *dependents = this->mDependents.find(*iter);
+    if (!dependents) { continue; }
+    TaskType::DependencyList::const_iterator
+      dependentIter = dependents->begin(),
+      dependentEnd = dependents->end();
+    for (; dependentIter != dependentEnd; ++dependentIter)
+    {
+      Node *child = this->mNodes.find(*dependentIter);
+      if (!child || TbbScheduler::hasPredecessor(*child, *iter)) { continue; }
+      this->link(*child, *iter);
+    }
+  }
+  if (!inserted.empty()) { this->mPlan.mIsValid = false; }
+}
+
+void TbbScheduler::removeNodes(TbbScheduler::IdList &taskIds)
+{
+  IdList::const_iterator
+    iter = taskIds.begin(),
+    end = taskIds.end();
+  for (; iter != end; ++iter)
+  {
+    this->removeNode(*iter);
+  }
+}
+
+void TbbScheduler::removeNode(const TbbScheduler::TaskType::IdType taskId)
+{
+  Node *node = this->mNodes.find(taskId);
+  if (!node) { return; }
+
+  /// Dependents of a removed task are no longer held back by it
+  const TaskType::DependencyList *dependents = this->mDependents.find(taskId);
+  if (dependents)
+  {
+    TaskType::DependencyList::const_iterator
+      dependentIter = dependents->begin(),
+      dependentEnd = dependents->end();
+    for (; dependentIter != dependentEnd; ++dependentIter)
+    {
+      Node *child = this->mNodes.find(*dependentIter);
+      if (!child) { continue; }
+      this->unlink(*child, taskId);
+    }
+  }
+
+  /// Forget this task as a dependent of its own dependencies
+  const TaskType::DependencyList &dependencies = node->mTask->getDependencies();
+  TaskType::DependencyList::const_iterator
+    dependencyIter = dependencies.begin(),
+    dependencyEnd = dependencies.end();
   for (; dependencyIter != dependencyEnd; ++dependencyIter)
   {
-    /// Get the parent task
-    if (!this->mTasks.find(taskAccessor, dependencyIter->first)) { continue; }
-    TaskType::Pointer parentTask(taskAccessor->second);
+    this->removeDependent(*dependencyIter, taskId);
+  }
+
+  this->mNodes.erase(taskId);
+  this->mPlan.mIsValid = false;
+}
+
+void TbbScheduler::link(
+  TbbScheduler::Node &node,
+  const TbbScheduler::TaskType::IdType predecessor)
+{
+  node.mPredecessors.push_back(predecessor);
+}
+
+void TbbScheduler::unlink(
+  TbbScheduler::Node &node,
+  const TbbScheduler::TaskType::IdType predecessor)
+{
+  TaskType::DependencyList::iterator iter = std::find(node.mPredecessors.begin(), node.mPredecessors.end(), predecessor);
+  if (iter != node.mPredecessors.end()) { node.mPredecessors.erase(iter); }
+}
+
+void TbbScheduler::addDependent(
+  const TbbScheduler::TaskType::IdType dependency,
+  const TbbScheduler::TaskType::IdType taskId)
+{
+  TaskType::DependencyList *dependents = this->mDependents.find(dependency);
+  if (!dependents)
+  {
+    this->mDependents.insert(dependency);
+    dependents = this->mDependents.find(dependency);
+  }
+  dependents->push_back(taskId);
+}
+
+void TbbScheduler::removeDependent(
+  const TbbScheduler::TaskType::IdType dependency,
+  const TbbScheduler::TaskType::IdType taskId)
+{
+  TaskType::DependencyList *dependents = this->mDependents.find(dependency);
+  if (!dependents) { return; }
+  TaskType::DependencyList::iterator iter = std::find(dependents->begin(), dependents->end(), taskId);
+  if (iter == dependents->end()) { return; }
+  dependents->erase(iter);
+  if (dependents->empty()) { this->mDependents.erase(dependency); }
+}
+
+bool TbbScheduler::hasPredecessor(
+  const TbbScheduler::Node &node,
+  const TbbScheduler::TaskType::IdType predecessor)
+{
+  return (std::find(node.mPredecessors.begin(), node.mPredecessors.end(), predecessor) != node.mPredecessors.end());
+}
+
+///
+/// @note A compiled plan or stage only reaches its nodes through their
+///   handles; one that no longer resolves means the plan was used after a
+///   graph change without being recompiled.
+///
+TbbScheduler::Node& TbbScheduler::resolve(
+  TbbScheduler::NodeMap &nodes,
+  const TbbScheduler::NodeMap::Handle &handle)
+{
+  Node *node = nodes.find(handle);
+  assert(node);
+  return *node;
+}
+
+///
+/// @note Worker reported in traces. The legacy TBB API does not number its
+///   threads, so each thread is numbered on its first traced task.
+///
+uint32_t TbbScheduler::getThreadIndex()
+{
+  static tbb::atomic<uint32_t> NEXT;
+  static THREAD_LOCAL uint32_t INDEX = ~0u;
+
+  if (INDEX == ~0u) { INDEX = NEXT.fetch_and_increment(); }
+  return INDEX;
+}
+
+///
+/// @note Ranks each task by the longest chain of measured durations from it
+///   to a sink. Must only be called while the graph is idle.
+///
+void TbbScheduler::updateCriticalPath()
+{
+  /// Local vars; nodes are addressed by their dense position
+  const uint32_t count = this->mNodes.size();
+  uint32_t_v pending(count), order;
+  order.reserve(count);
+
+  /// Topological order (Kahn) over the linked edges
+  for (uint32_t position = 0; position < count; ++position)
+  {
+    pending[position] = this->mNodes[position].mPredecessors.size();
+    if (!pending[position]) { order.push_back(position); }
+  }
+  for (uint32_t cursor = 0; cursor < order.size(); ++cursor)
+  {
+    const TaskType::IdType parentId = this->mNodes.getKey(order[cursor]);
+    const TaskType::DependencyList *dependents = this->mDependents.find(parentId);
+    if (!dependents) { continue; }
+    TaskType::DependencyList::const_iterator
+      iter = dependents->begin(),
+      end = dependents->end();
+    for (; iter != end; ++iter)
+    {
+      const size_t child = this->mNodes.getPosition(*iter);
+      if ((child == NodeMap::NPOS) || !TbbScheduler::hasPredecessor(this->mNodes[child], parentId)) { continue; }
+      if (--pending[child] == 0) { order.push_back(child); }
+    }
+  }
 
-    /// Create task graph edges
-    TaskMap &taskMap = dependencyIter->second;
-    if (taskMap.empty())
+  /// Accumulate path lengths from the sinks upwards
+  this->mLongestPath = 0;
+  uint32_t_v::reverse_iterator
+    orderIter = order.rbegin(),
+    orderEnd = order.rend();
+  for (; orderIter != orderEnd; ++orderIter)
+  {
+    Node &node = this->mNodes[*orderIter];
+    uint64_t longest = 0;
+    const TaskType::DependencyList *dependents = this->mDependents.find(this->mNodes.getKey(*orderIter));
+    if (dependents)
     {
-      /// Task has no dependency(s)
-      tbb::executable_node<TaskType::InputType> head(this->mGraph, parentTask->getFunctor());
-      tbb::make_edge(this->mRootNode, head);
+      TaskType::DependencyList::const_iterator
+        iter = dependents->begin(),
+        end = dependents->end();
+      for (; iter != end; ++iter)
+      {
+        const Node *child = this->mNodes.find(*iter);
+        if (!child) { continue; }
+        longest = std::max(longest, child->mCriticalPath);
+      }
     }
-    else
+    node.mCriticalPath = std::max<uint64_t>(1, node.mTask->getDuration()) + longest;
+    this->mLongestPath = std::max(this->mLongestPath, node.mCriticalPath);
+  }
+}
+
+///
+/// @note Flattens the linked graph into mPlan: nodes grouped by depth,
+///   successor positions in one array and a pending counter per node, so
+///   run() only resolves the handle of each node it queues. A dependency cycle is a registration error
+///   and asserts; without assertions, the tasks on and behind the cycle
+///   are left out of the plan. Must only be called while the graph is idle.
+///
+void TbbScheduler::compile()
+{
+  /// Local vars; nodes are addressed by their dense position
+  const uint32_t count = this->mNodes.size();
+  uint32_t_v pending(count), depth(count), order, positions(count);
+  order.reserve(count);
+
+  /// Topological order (Kahn) over the linked edges
+  for (uint32_t position = 0; position < count; ++position)
+  {
+    pending[position] = this->mNodes[position].mPredecessors.size();
+    if (!pending[position]) { order.push_back(position); }
+  }
+  for (uint32_t cursor = 0; cursor < order.size(); ++cursor)
+  {
+    const uint32_t parent = order[cursor];
+    const TaskType::IdType parentId = this->mNodes.getKey(parent);
+    const TaskType::DependencyList *dependents = this->mDependents.find(parentId);
+    if (!dependents) { continue; }
+    TaskType::DependencyList::const_iterator
+      iter = dependents->begin(),
+      end = dependents->end();
+    for (; iter != end; ++iter)
+    {
+      const size_t child = this->mNodes.getPosition(*iter);
+      if ((child == NodeMap::NPOS) || !TbbScheduler::hasPredecessor(this->mNodes[child], parentId)) { continue; }
+      depth[child] = std::max(depth[child], depth[parent] + 1);
+      if (--pending[child] == 0) { order.push_back(child); }
+    }
+  }
+
+  /// Every node is ordered unless some lie on a dependency cycle
+  assert(order.size() == count);
+
+  /// Level offsets, then nodes in level order
+  Plan &plan = this->mPlan;
+  const uint32_t size = order.size();
+  plan.mLevels.assign(1, 0);
+  uint32_t_v::const_iterator
+    orderIter = order.begin(),
+    orderEnd = order.end();
+  for (; orderIter != orderEnd; ++orderIter)
+  {
+    const uint32_t level = depth[*orderIter];
+    if ((level + 2) > plan.mLevels.size()) { plan.mLevels.resize(level + 2, 0); }
+    ++plan.mLevels[level + 1];
+  }
+  for (uint32_t level = 1; level < plan.mLevels.size(); ++level)
+  {
+    plan.mLevels[level] += plan.mLevels[level - 1];
+  }
+
+  uint32_t_v cursors(plan.mLevels.begin(), plan.mLevels.end());
+  plan.mHandles.resize(size);
+  plan.mPredecessorCounts.resize(size);
+  for (orderIter = order.begin(); orderIter != orderEnd; ++orderIter)
+  {
+    const uint32_t position = cursors[depth[*orderIter]]++;
+    Node &node = this->mNodes[*orderIter];
+    node.mPosition = position;
+    positions[*orderIter] = position;
+    plan.mHandles[position] = this->mNodes.getHandle(this->mNodes.getKey(*orderIter));
+    plan.mPredecessorCounts[position] = node.mPredecessors.size();
+  }
+
+  /// Successor positions of each node
+  plan.mSuccessorOffsets.assign(1, 0);
+  plan.mSuccessorOffsets.reserve(size + 1);
+  plan.mSuccessors.clear();
+  for (uint32_t position = 0; position < size; ++position)
+  {
+    const TaskType::IdType parentId = plan.mHandles[position].mKey;
+    const TaskType::DependencyList *dependents = this->mDependents.find(parentId);
+    if (dependents)
     {
-      /// Task has dependency(s)
-      TaskMap::iterator
-        taskIter = taskMap.begin(),
-        taskEnd = taskMap.end();
-      for (; taskIter != taskEnd; ++taskIter)
+      TaskType::DependencyList::const_iterator
+        iter = dependents->begin(),
+        end = dependents->end();
+      for (; iter != end; ++iter)
       {
-        TaskType::Pointer childTask(taskIter->second);
-        tbb::executable_node<TaskType::InputType> tail(this->mGraph, parentTask->getFunctor());
-        tbb::executable_node<TaskType::InputType> head(this->mGraph, childTask->getFunctor());
-        tbb::make_edge(tail, head);
+        const size_t child = this->mNodes.getPosition(*iter);
+        if ((child == NodeMap::NPOS) || pending[child] || !TbbScheduler::hasPredecessor(this->mNodes[child], parentId)) { continue; }
+        plan.mSuccessors.push_back(positions[child]);
       }
     }
+    plan.mSuccessorOffsets.push_back(plan.mSuccessors.size());
   }
 
-  /// Update graph dirty flag
-  this->setIsGraphDirty(false);
+  /// Per-node run state only grows; no task is suspended between runs
+  if (size > plan.mCapacity)
+  {
+    plan.mPending.reset(new tbb::atomic<uint32_t>[size]);
+    plan.mSuspensions.reset(new Suspension[size]);
+    plan.mElapsed.reset(new uint64_t[size]);
+    for (uint32_t position = 0; position < size; ++position)
+    {
+      plan.mSuspensions[position].bind(&TbbScheduler::resume, this, &plan.mSuspensions[position]);
+      plan.mElapsed[position] = 0;
+    }
+    plan.mCapacity = size;
+  }
+  plan.mIsValid = true;
+
+  /// Pipeline stages follow the same graph, so they are rebuilt with it
+  this->buildStages();
 }
 
-void TbbScheduler::run(TaskType::InputType input, const bool wait)
+///
+/// @note Groups the recurring tasks by their depth among recurring
+///   dependencies. Called by compile(), so that pipeline() reuses the
+///   stages until the graph changes. Must only be called while the graph
+///   is idle.
+///
+void TbbScheduler::buildStages()
 {
-  if (this->getIsGraphDirty()) { this->schedule(); }
-  this->mRootNode.try_put(input);
-  if (wait) { this->mGraph.wait_for_all(); }
+  /// Local vars; nodes are addressed by their dense position
+  const uint32_t count = this->mNodes.size();
+  uint32_t_v pending(count), depth(count), order;
+
+  /// Topological order (Kahn) over the edges between recurring tasks
+  for (uint32_t position = 0; position < count; ++position)
+  {
+    const Node &node = this->mNodes[position];
+    if (!node.mTask->getRecurring()) { continue; }
+    uint32_t recurring = 0;
+    TaskType::DependencyList::const_iterator
+      predecessorIter = node.mPredecessors.begin(),
+      predecessorEnd = node.mPredecessors.end();
+    for (; predecessorIter != predecessorEnd; ++predecessorIter)
+    {
+      if (this->mNodes.find(*predecessorIter)->mTask->getRecurring()) { ++recurring; }
+    }
+    pending[position] = recurring;
+    if (!recurring) { order.push_back(position); }
+  }
+  for (uint32_t cursor = 0; cursor < order.size(); ++cursor)
+  {
+    const uint32_t parent = order[cursor];
+    const TaskType::IdType parentId = this->mNodes.getKey(parent);
+    const TaskType::DependencyList *dependents = this->mDependents.find(parentId);
+    if (!dependents) { continue; }
+    TaskType::DependencyList::const_iterator
+      iter = dependents->begin(),
+      end = dependents->end();
+    for (; iter != end; ++iter)
+    {
+      const size_t child = this->mNodes.getPosition(*iter);
+      if ((child == NodeMap::NPOS) || !this->mNodes[child].mTask->getRecurring() || !TbbScheduler::hasPredecessor(this->mNodes[child], parentId)) { continue; }
+      depth[child] = std::max(depth[child], depth[parent] + 1);
+      if (--pending[child] == 0) { order.push_back(child); }
+    }
+  }
+
+  /// One stage per level; serial if any of its tasks is serial
+  std::vector<std::vector<NodeMap::Handle> > levels;
+  std::vector<bool> serial;
+  uint32_t_v::const_iterator
+    orderIter = order.begin(),
+    orderEnd = order.end();
+  for (; orderIter != orderEnd; ++orderIter)
+  {
+    const uint32_t level = depth[*orderIter];
+    if (level >= levels.size())
+    {
+      levels.resize(level + 1);
+      serial.resize(level + 1, false);
+    }
+    const TaskType::IdType taskId = this->mNodes.getKey(*orderIter);
+    levels[level].push_back(this->mNodes.getHandle(taskId));
+    if (this->mNodes[*orderIter].mTask->getSerial()) { serial[level] = true; }
+  }
+
+  this->mPipeline.clear();
+  this->mStages.clear();
+  if (levels.empty()) { return; }
+  this->mPipeline.add_filter(this->mFrameSource);
+  for (uint32_t level = 0; level < levels.size(); ++level)
+  {
+    SharedPointer<StageFilter> stage(new StageFilter(this->mNodes, this->mTracer, this->mBudget, this->mArenas, this->mFrameSource, serial[level]));
+    stage->mHandles.swap(levels[level]);
+    this->mPipeline.add_filter(*stage);
+    this->mStages.push_back(stage);
+  }
+  this->mPipeline.add_filter(this->mFrameSink);
 }
 
-void TbbScheduler::clear()
+void TbbScheduler::runPipeline()
 {
-  this->mTasks.clear();
-  this->mDependencies.clear();
-  this->setIsGraphDirty(false);
+  this->mPipeline.run(this->mFramesInFlight ? this->mFramesInFlight : 1);
+  this->completeRun();
+}
+
+///
+/// @note Continuations run as a task of their own group, outside the run's
+///   groups, so that one that starts and waits for the next run does not
+///   wait for the task that completed this one.
+///
+void TbbScheduler::completeRun()
+{
+  const bool hasContinuations = this->mRuns.complete();
+  {
+    boost::mutex::scoped_lock lock(this->mDoneMutex);
+    this->mDoneCondition.notify_all();
+  }
+  if (hasContinuations) { this->mContinuationGroup.run(std::tr1::bind(&RunTracker::callContinuations, &this->mRuns)); }
+}
+
+///
+/// @note Ranks a task as it becomes ready. Ranks rise with the order in
+///   which tasks become ready, so a queued task can only be overtaken by
+///   tasks of a higher priority, and by at most STARVATION_LIMIT of them
+///   per level. Within a priority level, tasks on longer paths get a head
+///   start of up to STARVATION_LIMIT - 1 ranks.
+///
+TbbScheduler::ReadyEntry TbbScheduler::rank(const uint32_t position)
+{
+  /// Local vars
+  Node *node = &TbbScheduler::resolve(this->mNodes, this->mPlan.mHandles[position]);
+  const int64_t priority = std::max<int64_t>(
+    Task::Priority::LOW,
+    std::min<int64_t>(Task::Priority::HIGH, node->mTask->getPriority()));
+  const int64_t headStart = this->mLongestPath
+    ? static_cast<int64_t>((node->mCriticalPath * (TbbScheduler::STARVATION_LIMIT - 1)) / this->mLongestPath)
+    : 0;
+
+  const ReadyEntry entry = { node, this->mSequence.fetch_and_increment() - (priority * TbbScheduler::STARVATION_LIMIT) - headStart };
+  return entry;
+}
+
+///
+/// @note Spawns one ReadyBody per task just queued. Pushes and pops pair
+///   up, so every queued task runs exactly once, in rank order.
+///
+void TbbScheduler::spawn(const uint32_t count)
+{
+  for (uint32_t index = 0; index < count; ++index)
+  {
+    this->mRunGroup.run(ReadyBody(this));
+  }
+}
+
+void TbbScheduler::dispatch()
+{
+  /// Local vars
+  ReadyEntry entry;
+
+  if (!this->mReady.try_pop(entry)) { return; }
+
+  /// Main-thread tasks are left to wait()
+  if (entry.mNode->mTask->getMainThread())
+  {
+    this->mMainQueue.push(entry.mNode);
+    boost::mutex::scoped_lock lock(this->mDoneMutex);
+    this->mDoneCondition.notify_all();
+    return;
+  }
+  this->execute(*entry.mNode);
+}
+
+void TbbScheduler::execute(TbbScheduler::Node &node)
+{
+  /// Local vars
+  Suspension &suspension = this->mPlan.mSuspensions[node.mPosition];
+  uint64_t &elapsed = this->mPlan.mElapsed[node.mPosition];
+
+  /// Skip this frame if the run is at risk of overrunning its budget, or
+  /// if no input has changed since the last run; a resumed task is never skipped
+  bool isSkipped = false;
+  if (!suspension.getPoint())
+  {
+    const uint32_t deferredFrames = node.mDeferredFrames;
+    const bool isShed = this->mBudget.shed(this->mRunStart, node.mCriticalPath, node.mTask->getPriority(), node.mTask->getRecurring(), deferredFrames);
+    node.mDeferredFrames = isShed ? deferredFrames + 1 : 0;
+    isSkipped = isShed || node.mTask->isUpToDate();
+    if (!isSkipped) { node.mTask->captureInputs(); }
+  }
+
+  /// Execute task and record its duration
+  if (!isSkipped)
+  {
+    /// Call the task again at once if its completion arrived before it returned
+    uint32_t state = Suspension::State::NONE;
+    Suspension *previous = Suspension::setCurrent(&suspension);
+    FrameArena *arena = FrameArena::setCurrent(this->mArenas[0].get());
+    do
+    {
+      const uint64_t start = Utilities::BasicTimer::now();
+      {
+        RSSD_TRACE_TASK(this->mTracer, *node.mTask, this->mInput.mIndex, TbbScheduler::getThreadIndex());
+        node.mTask->getFunctor()(this->mInput);
+      }
+      elapsed += Utilities::BasicTimer::now() - start;
+      state = suspension.settle();
+    } while (state == Suspension::State::RESUMED);
+    FrameArena::setCurrent(arena);
+    Suspension::setCurrent(previous);
+
+    /// Suspended; the worker moves on and resume() queues the task again
+    if (state == Suspension::State::SUSPENDED) { return; }
+
+    node.mTask->sampleDuration(elapsed / Utilities::Timer::NSEC_PER_USEC);
+    elapsed = 0;
+    node.mTask->publishOutput();
+    this->mBudget.completeTask(this->mRunStart, node.mTask->getDeadline());
+  }
+
+  /// Queue the successors this task was the last to hold back
+  const uint32_t
+    begin = this->mPlan.mSuccessorOffsets[node.mPosition],
+    end = this->mPlan.mSuccessorOffsets[node.mPosition + 1];
+  uint32_t released = 0;
+  for (uint32_t index = begin; index != end; ++index)
+  {
+    const uint32_t successor = this->mPlan.mSuccessors[index];
+    if (--this->mPlan.mPending[successor] != 0) { continue; }
+    this->mReady.push(this->rank(successor));
+    ++released;
+  }
+  this->spawn(released);
+  /// The last task ends the frame, whether or not anyone waits on the run
+  if (--this->mRunRemaining == 0)
+  {
+    this->mBudget.completeFrame(this->mRunStart);
+    this->mArenas[0]->reset();
+    this->completeRun();
+  }
+}
+
+///
+/// @note Resumption callback of a suspended task; runs on the thread that
+///   signalled the completion. A main-thread task is handed back to wait().
+///
+void TbbScheduler::resume(void *scheduler, void *suspension)
+{
+  TbbScheduler *self = static_cast<TbbScheduler*>(scheduler);
+  const uint32_t position = static_cast<Suspension*>(suspension) - self->mPlan.mSuspensions.get();
+  self->mReady.push(self->rank(position));
+  self->spawn(1);
+  ++self->mResumeCount;
+  boost::mutex::scoped_lock lock(self->mDoneMutex);
+  self->mDoneCondition.notify_all();
+}
+
+///
+/// @class TbbScheduler::FrameSource
+///
+
+void TbbScheduler::FrameSource::reset(const Frame &first, const uint32_t frameCount, const uint32_t slotCount)
+{
+  this->mFirst = first;
+  this->mFrame = 0;
+  this->mFrameCount = frameCount;
+  this->mFrames.resize(std::max<uint32_t>(1, slotCount));
+  this->mStarts.resize(this->mFrames.size());
+}
+
+void* TbbScheduler::FrameSource::operator()(void *item)
+{
+  if (this->mFrame >= this->mFrameCount) { return NULL; }
+  const uint32_t slot = this->mFrame % this->mFrames.size();
+  Frame &frame = this->mFrames[slot];
+  frame.mIndex = this->mFirst.mIndex + this->mFrame++;
+  frame.mSlot = slot;
+  this->mStarts[slot] = FrameBudget::now();
+  return &frame;
+}
+
+///
+/// @class TbbScheduler::FrameSink
+///
+
+///
+/// @note Every stage has finished the frame, so its temporaries can go
+///   before the token is reused for a later frame.
+///
+void* TbbScheduler::FrameSink::operator()(void *item)
+{
+  /// Local vars
+  const uint32_t slot = static_cast<const Frame*>(item)->mSlot;
+
+  this->mBudget.completeFrame(this->mSource.getStart(slot));
+  this->mArenas[slot]->reset();
+  return NULL;
+}
+
+///
+/// @class TbbScheduler::StageFilter
+///
+
+TbbScheduler::StageFilter::StageFilter(TbbScheduler::NodeMap &nodes, Tracer &tracer, FrameBudget &budget, TbbScheduler::ArenaList &arenas, const FrameSource &source, const bool isSerial) :
+  tbb::filter(isSerial ? tbb::filter::serial_in_order : tbb::filter::parallel),
+  mNodes(nodes),
+  mTracer(tracer),
+  mBudget(budget),
+  mArenas(arenas),
+  mSource(source),
+  mIsSerial(isSerial)
+{
+
+}
+
+void* TbbScheduler::StageFilter::operator()(void *item)
+{
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, this->mHandles.size()), StageBody(this, static_cast<const Frame*>(item)));
+  return item;
+}
+
+void TbbScheduler::StageFilter::execute(const tbb::blocked_range<size_t> &range, const Frame &frame) const
+{
+  /// Local vars
+  const uint64_t frameStart = this->mSource.getStart(frame.mSlot);
+
+  for (size_t index = range.begin(); index != range.end(); ++index)
+  {
+    Node *node = &TbbScheduler::resolve(this->mNodes, this->mHandles[index]);
+
+    /// Skip this frame if the frame is at risk of overrunning its budget, or
+    /// if no input has changed since the task last ran in this frame slot
+    const uint32_t deferredFrames = node->mDeferredFrames;
+    const bool isShed = this->mBudget.shed(frameStart, node->mCriticalPath, node->mTask->getPriority(), true, deferredFrames);
+    node->mDeferredFrames = isShed ? deferredFrames + 1 : 0;
+    if (isShed || node->mTask->isUpToDate(frame.mSlot)) { continue; }
+    node->mTask->captureInputs(frame.mSlot);
+
+    const uint64_t start = Utilities::BasicTimer::now();
+    {
+      RSSD_TRACE_TASK(this->mTracer, *node->mTask, frame.mIndex, TbbScheduler::getThreadIndex());
+      FrameArena *arena = FrameArena::setCurrent(this->mArenas[frame.mSlot].get());
+      node->mTask->getFunctor()(frame);
+      FrameArena::setCurrent(arena);
+    }
+
+    /// @note Parallel stages may overlap with themselves
+    if (this->mIsSerial) { node->mTask->sampleDuration((Utilities::BasicTimer::now() - start) / Utilities::Timer::NSEC_PER_USEC); }
+    node->mTask->publishOutput();
+    this->mBudget.completeTask(frameStart, node->mTask->getDeadline());
+  }
 }
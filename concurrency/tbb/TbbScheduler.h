@@ -34,6 +34,13 @@
 #define RSSD_CORE_CONCURRENCY_IMPL_TBBSCHEDULER_H
 
 #include "System"
+#include "Pattern"
+#include "Utilities"
+#include "concurrency/Completion.h"
+#include "concurrency/FrameArena.h"
+#include "concurrency/FrameBudget.h"
+#include "concurrency/RunHandle.h"
+#include "concurrency/Trace.h"
 #include "concurrency/tbb/TbbTraits.h"
 
 namespace RSSD {
@@ -45,27 +52,258 @@ class TbbScheduler
 {
 public:
   typedef TbbTraits::TaskType TaskType;
-  typedef tbb::concurrent_hash_map<TaskType::IdType, TaskType::Pointer> TaskMap; /// @note [Task ID] => [Task node structure]
-  typedef tbb::concurrent_hash_map<TaskType::IdType, TaskMap> TaskDependencyMap; /// @note [Parent task] => [List of child tasks]
+  typedef std::vector<TaskType::Pointer> TaskList;
+  typedef std::vector<TaskType::IdType> IdList;
+  typedef std::vector<SharedPointer<FrameArena> > ArenaList;
+  typedef RunHandle<TbbScheduler> HandleType;
+
+  struct Node
+  {
+    Node() : mCriticalPath(0), mPosition(0) { this->mDeferredFrames = 0; }
+
+    TaskType::Pointer mTask;
+    TaskType::DependencyList mPredecessors; /// @note Registered tasks this task currently waits on
+    uint64_t mCriticalPath; /// @note Longest measured path (us) from this task to the end of the graph
+    tbb::atomic<uint32_t> mDeferredFrames; /// @note Consecutive frames this task has been shed from
+    uint32_t mPosition; /// @note Position in the compiled Plan
+  }; /// struct Node
+
+  typedef Pattern::SlotMap<Node> NodeMap; /// @note [Task ID] => [Persistent graph node]
+
+  ///
+  /// @brief Graph compiled for run(); nodes are stored level by level.
+  /// @note Successors of the node at position P are
+  ///   mSuccessors[mSuccessorOffsets[P]] to mSuccessors[mSuccessorOffsets[P + 1]].
+  ///   Rebuilt only after the graph has changed. Nodes are held by handle,
+  ///   so a plan that outlives a graph change never reaches a node that
+  ///   has since been removed, replaced or moved.
+  ///
+  struct Plan
+  {
+    Plan() : mCapacity(0), mIsValid(false) {}
+
+    std::vector<NodeMap::Handle> mHandles;
+    uint32_t_v mLevels; /// @note Position of the first node of each level, plus the end position
+    uint32_t_v mSuccessorOffsets;
+    uint32_t_v mSuccessors; /// @note Plan positions
+    uint32_t_v mPredecessorCounts;
+    boost::scoped_array<tbb::atomic<uint32_t> > mPending; /// @note Predecessors left to execute in the current run()
+    boost::scoped_array<Suspension> mSuspensions; /// @note Await state of each node in the current run()
+    boost::scoped_array<uint64_t> mElapsed; /// @note Execution time (ns) accumulated across suspensions
+    uint32_t mCapacity;
+    bool mIsValid;
+  }; /// struct Plan
+
+  ///
+  /// @brief Runs the best ready task, which need not be the one that queued it.
+  ///
+  struct ReadyBody
+  {
+    ReadyBody(TbbScheduler *scheduler) : mScheduler(scheduler) {}
+    void operator()() const { this->mScheduler->dispatch(); }
+
+    TbbScheduler *mScheduler;
+  }; /// struct ReadyBody
+
+  ///
+  /// @brief Queued graph change; a removal has no task.
+  ///
+  struct Operation
+  {
+    TaskType::Pointer mTask;
+    TaskType::IdType mTaskId;
+  }; /// struct Operation
+
+  struct ReadyEntry
+  {
+    Node *mNode;
+    int64_t mRank; /// @note Lower ranks are dispatched first
+  }; /// struct ReadyEntry
+
+  struct ReadyCompare
+  {
+    bool operator()(const ReadyEntry &lhs, const ReadyEntry &rhs) const { return (lhs.mRank > rhs.mRank); }
+  }; /// struct ReadyCompare
+
+  ///
+  /// @brief Pipeline input; emits one Frame token per frame.
+  ///
+  class FrameSource : public tbb::filter
+  {
+  public:
+    FrameSource() : tbb::filter(tbb::filter::serial_in_order), mFrame(0), mFrameCount(0) {}
+    void reset(const Frame &first, const uint32_t frameCount, const uint32_t slotCount);
+    virtual void* operator()(void *item);
+    FORCE_INLINE uint64_t getStart(const uint32_t slot) const { return this->mStarts[slot]; }
+
+  protected:
+    Frame mFirst;
+    uint32_t mFrame;
+    uint32_t mFrameCount;
+    std::vector<Frame> mFrames; /// @note One token per frame slot
+    std::vector<uint64_t> mStarts; /// @note Start time (us) of the frame each slot holds
+  }; /// class FrameSource
+
+  ///
+  /// @brief Pipeline output; retires frames in order.
+  /// @note A token is only reused for frame N + frames in flight once
+  ///   frame N has left the pipeline, so frame slots never overlap.
+  ///
+  class FrameSink : public tbb::filter
+  {
+  public:
+    FrameSink(FrameBudget &budget, ArenaList &arenas, const FrameSource &source) : tbb::filter(tbb::filter::serial_in_order), mBudget(budget), mArenas(arenas), mSource(source) {}
+    virtual void* operator()(void *item);
+
+  protected:
+    FrameBudget &mBudget;
+    ArenaList &mArenas;
+    const FrameSource &mSource;
+  }; /// class FrameSink
+
+  ///
+  /// @brief Pipeline stage running one topological level of recurring tasks.
+  /// @note The stage is serial in order if any of its tasks is serial.
+  ///
+  class StageFilter : public tbb::filter
+  {
+  public:
+    StageFilter(NodeMap &nodes, Tracer &tracer, FrameBudget &budget, ArenaList &arenas, const FrameSource &source, const bool isSerial);
+    virtual void* operator()(void *item);
+    void execute(const tbb::blocked_range<size_t> &range, const Frame &frame) const;
+
+    std::vector<NodeMap::Handle> mHandles;
+
+  protected:
+    NodeMap &mNodes;
+    Tracer &mTracer;
+    FrameBudget &mBudget;
+    ArenaList &mArenas;
+    const FrameSource &mSource;
+    bool mIsSerial;
+  }; /// class StageFilter
+
+  struct StageBody
+  {
+    StageBody(const StageFilter *stage, const Frame *frame) : mStage(stage), mFrame(frame) {}
+    void operator()(const tbb::blocked_range<size_t> &range) const { this->mStage->execute(range, *this->mFrame); }
+
+    const StageFilter *mStage;
+    const Frame *mFrame;
+  }; /// struct StageBody
+
+  template <typename BODY>
+  struct RangeBody
+  {
+    RangeBody(const BODY &body) : mBody(body), mArena(FrameArena::getCurrent()) {}
+    void operator()(const tbb::blocked_range<size_t> &range) const
+    {
+      FrameArena *arena = FrameArena::setCurrent(this->mArena);
+      this->mBody(range.begin(), range.end());
+      FrameArena::setCurrent(arena);
+    }
+
+    const BODY &mBody;
+    FrameArena *mArena; /// @note Arena of the caller, current wherever a chunk runs
+  }; /// struct RangeBody
+
+  typedef Pattern::SlotMap<TaskType::DependencyList> DependentMap; /// @note [Dependency ID] => [Dependent task IDs]
+  typedef Pattern::SlotMap<TaskType::Pointer> RegistryMap; /// @note [Task ID] => [Task], including changes not yet applied
+  typedef std::vector<Operation> OperationList;
+  typedef tbb::concurrent_priority_queue<ReadyEntry, ReadyCompare> ReadyQueue;
+
+  /// @note A ready task can be overtaken by at most this many later tasks
+  ///   per priority level above its own, so LOW tasks cannot starve.
+  static const int64_t STARVATION_LIMIT = 256;
+  static const uint32_t CRITICAL_PATH_INTERVAL = 32; /// @note Runs between critical path updates
+  static const uint32_t DEFAULT_FRAMES_IN_FLIGHT = 2;
 
   TbbScheduler();
   ~TbbScheduler();
   bool registerTask(const TaskType::Pointer task);
-  bool unregisterTask(const TaskType::IdType taskType);
+  bool unregisterTask(const TaskType::IdType taskId);
+  uint32_t registerTasks(const TaskList &tasks);
+  uint32_t unregisterTasks(const IdList &taskIds);
   void schedule();
-  void run(TaskType::InputType input = TaskType::InputType(), const bool wait = true);
+  HandleType run(TaskType::InputType input = TaskType::InputType(), const bool wait = true);
+  HandleType pipeline(const uint32_t frameCount, TaskType::InputType input = TaskType::InputType(), const bool wait = true);
+  void wait();
+  bool wait(const uint64_t run, const uint64_t timeout);
+  FORCE_INLINE bool isComplete(const uint64_t run) const { return this->mRuns.isComplete(run); }
+  FORCE_INLINE void then(const uint64_t run, const RunTracker::ContinuationType continuation, void *context) { this->mRuns.then(run, continuation, context); }
   void clear();
+  DEFINE_PROPERTY_INLINE(uint32_t, FramesInFlight, mFramesInFlight);
+  FORCE_INLINE Tracer& getTracer() { return this->mTracer; }
+  FORCE_INLINE FrameBudget& getBudget() { return this->mBudget; }
+  FORCE_INLINE FrameArena& getArena(const uint32_t slot = 0) { return *this->mArenas[slot]; } /// @note run() uses slot 0
+  FORCE_INLINE uint32_t getWorkerCount() const { return tbb::task_scheduler_init::default_num_threads(); }
+  template <typename BODY> void parallelFor(const size_t begin, const size_t end, const BODY &body);
 
 protected:
   DEFINE_PROPERTY_INLINE_VOLATILE(bool, IsGraphDirty, mIsGraphDirty);
+  void apply(OperationList &operations);
+  void insertNodes(const TaskList &tasks);
+  void removeNodes(IdList &taskIds);
+  void removeNode(const TaskType::IdType taskId);
+  void link(Node &node, const TaskType::IdType predecessor);
+  void unlink(Node &node, const TaskType::IdType predecessor);
+  void addDependent(const TaskType::IdType dependency, const TaskType::IdType taskId);
+  void removeDependent(const TaskType::IdType dependency, const TaskType::IdType taskId);
+  static bool hasPredecessor(const Node &node, const TaskType::IdType predecessor);
+  static Node& resolve(NodeMap &nodes, const NodeMap::Handle &handle);
+  static uint32_t getThreadIndex();
+  void updateCriticalPath();
+  void compile();
+  void buildStages();
+  void runPipeline();
+  void completeRun();
+  ReadyEntry rank(const uint32_t position);
+  void spawn(const uint32_t count);
+  void dispatch();
+  void execute(Node &node);
+  static void resume(void *scheduler, void *suspension);
 
   volatile bool mIsGraphDirty;
-  tbb::graph mGraph;
-  tbb::broadcast_node<TaskType::InputType> mRootNode;
-  TaskMap mTasks;
-  TaskDependencyMap mDependencies;
+  NodeMap mNodes;
+  DependentMap mDependents;
+  RegistryMap mRegistry;
+  OperationList mOperations; /// @note Graph changes in the order they were requested
+  OperationList mApplying; /// @note Scratch space for schedule(); swapped with mOperations
+  boost::mutex mRegistryMutex; /// @note Guards mRegistry and mOperations
+  TaskList mInsertBatch; /// @note Scratch space for schedule()
+  IdList mRemovalBatch; /// @note Scratch space for schedule()
+  Plan mPlan;
+  tbb::task_group mRunGroup; /// @note Runs the tasks of the current run()
+  ReadyQueue mReady; /// @note Tasks of the current run() whose predecessors have all executed
+  tbb::concurrent_queue<Node*> mMainQueue; /// @note Ready main-thread tasks; run by wait()
+  tbb::atomic<uint32_t> mRunRemaining; /// @note Tasks left to execute in the current run()
+  tbb::atomic<uint32_t> mResumeCount; /// @note Bumped by every resume(), so wait() can sleep while only suspended tasks remain
+  RunTracker mRuns;
+  boost::mutex mDoneMutex;
+  boost::condition_variable mDoneCondition; /// @note Signalled when a run completes, a main-thread task becomes ready or a task resumes
+  tbb::atomic<int64_t> mSequence;
+  uint64_t mLongestPath;
+  uint32_t mRunCount;
+  TaskType::InputType mInput;
+  uint64_t mRunStart; /// @note Start time (us) of the current run()
+  uint32_t mFramesInFlight;
+  FrameBudget mBudget;
+  ArenaList mArenas; /// @note [Frame slot]; reset as the frame in the slot retires. One lane per TBB thread and one for the waiting thread
+  tbb::pipeline mPipeline;
+  FrameSource mFrameSource;
+  FrameSink mFrameSink;
+  std::vector<SharedPointer<StageFilter> > mStages;
+  tbb::task_group mPipelineGroup; /// @note Runs non-blocking pipelines
+  tbb::task_group mContinuationGroup; /// @note Calls the continuations of completed runs
+  Tracer mTracer;
 }; /// struct TbbScheduler
 
+///
+/// Includes
+///
+
+#include "concurrency/tbb/TbbScheduler-inl.h"
+
 } /// namespace Impl
 } /// namespace Concurrency
 } /// namespace Core
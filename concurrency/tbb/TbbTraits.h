@@ -35,6 +35,7 @@
 
 #include "System"
 #include "concurrency/Task.h"
+#include "concurrency/Frame.h"
 
 namespace RSSD {
 namespace Core {
@@ -44,19 +45,20 @@ namespace Impl {
 struct TbbTraits
 {
   typedef uint32_t IdType;
-  typedef tbb::continue_msg InputType;
+  typedef Frame InputType; /// @note Typed results travel through Ports indexed by the frame
   typedef void OutputType;
   typedef BaseTask<TbbTraits> TaskType;
 
+  ///
+  /// @note IDs are handed out densely from one shared counter, so the task
+  ///   graph's SlotMap touches as few index pages as there are tasks.
+  ///
   static IdType generateTaskId()
   {
-    static volatile bool INITIALIZED = false;
     static const IdType INITIAL_VALUE = 1;
-    static const IdType STEP_SIZE = 1;
-    static tbb::atomic<IdType> COUNTER;
-    if (!INITIALIZED) { COUNTER = INITIAL_VALUE; INITIALIZED = true; }
+    static tbb::atomic<IdType> COUNTER; /// @note Zero-initialised before any thread starts
 
-    return COUNTER.fetch_and_add(STEP_SIZE);
+    return INITIAL_VALUE + COUNTER.fetch_and_increment();
   }
 }; /// struct TbbTraits
 
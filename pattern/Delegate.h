@@ -0,0 +1,104 @@
+///
+/// @file Delegate.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by Royal Society of Secret Design
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+/// 		this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+/// 		this list of conditions and the following disclaimer in the documentation
+/// 		and/or other materials provided with the distribution.
+///    * Neither the name of Royal Society of Secret Design nor the names of its
+/// 		contributors may be used to endorse or promote products derived from
+/// 		this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+#ifndef RSSD_CORE_PATTERN_DELEGATE_H
+#define RSSD_CORE_PATTERN_DELEGATE_H
+
+#include "System"
+
+namespace RSSD {
+namespace Core {
+namespace Pattern {
+
+///
+/// @brief Non-owning callable for void(T&), bound at compile time.
+/// @note Holds an object pointer and a thunk instantiated for the exact
+///   member function or free function, so invoking it is one indirect
+///   call with no virtual dispatch, allocation or reference counting.
+///   The delegate does not keep its object alive. Example:
+///
+///   Delegate<Input> delegate = Delegate<Input>::bind<Camera, &Camera::onInput>(&camera);
+///   delegate(input);
+///
+template <typename T>
+class Delegate
+{
+public:
+  typedef void (*ThunkType)(void *object, T &argument);
+
+  Delegate() : mObject(NULL), mThunk(NULL) {}
+
+  template <typename C, void (C::*METHOD)(T&)>
+  static FORCE_INLINE Delegate bind(C *object)
+  {
+    return Delegate(object, &Delegate<T>::invokeMethod<C, METHOD>);
+  }
+
+  template <typename C, void (C::*METHOD)(T&) const>
+  static FORCE_INLINE Delegate bind(const C *object)
+  {
+    return Delegate(const_cast<C*>(object), &Delegate<T>::invokeConstMethod<C, METHOD>);
+  }
+
+  template <void (*FUNCTION)(T&)>
+  static FORCE_INLINE Delegate bind()
+  {
+    return Delegate(NULL, &Delegate<T>::invokeFunction<FUNCTION>);
+  }
+
+  FORCE_INLINE void operator()(T &argument) const { this->mThunk(this->mObject, argument); }
+  FORCE_INLINE bool isBound() const { return (this->mThunk != NULL); }
+  FORCE_INLINE const void* getObject() const { return this->mObject; }
+  FORCE_INLINE bool operator ==(const Delegate &value) const { return ((this->mObject == value.mObject) && (this->mThunk == value.mThunk)); }
+  FORCE_INLINE bool operator !=(const Delegate &value) const { return !this->operator ==(value); }
+
+protected:
+  Delegate(void *object, const ThunkType thunk) : mObject(object), mThunk(thunk) {}
+
+  template <typename C, void (C::*METHOD)(T&)>
+  static void invokeMethod(void *object, T &argument) { (static_cast<C*>(object)->*METHOD)(argument); }
+
+  template <typename C, void (C::*METHOD)(T&) const>
+  static void invokeConstMethod(void *object, T &argument) { (static_cast<const C*>(object)->*METHOD)(argument); }
+
+  template <void (*FUNCTION)(T&)>
+  static void invokeFunction(void *object, T &argument) { FUNCTION(argument); }
+
+  void *mObject;
+  ThunkType mThunk;
+}; /// class Delegate
+
+} /// namespace Pattern
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_CORE_PATTERN_DELEGATE_H
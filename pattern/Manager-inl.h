@@ -16,18 +16,16 @@ Manager<ITEM>::~Manager()
 template <typename ITEM>
 typename Manager<ITEM>::Handle Manager<ITEM>::get(const ITEM &item)
 {
-	Handle handle = std::find(
-		this->_items.begin(),
-		this->_items.end(),
-		item);
-	return handle;
+	typename IndexMap::const_iterator iter = this->_index.find(item);
+	if (iter == this->_index.end())
+		return this->_items.end();
+	return (this->_items.begin() + iter->second);
 }
 
 template <typename ITEM>
 bool Manager<ITEM>::has(const ITEM &item)
 {
-	Handle handle = this->get(item);
-	return (handle != this->_items.end());
+	return (this->_index.find(item) != this->_index.end());
 }
 
 template <typename ITEM>
@@ -39,7 +37,7 @@ uint32_t Manager<ITEM>::size() const
 template <typename ITEM>
 bool Manager<ITEM>::add(ITEM item)
 {
-	if (this->has(item))
+	if (!this->_index.insert(std::make_pair(item, static_cast<uint32_t>(this->_items.size()))).second)
 		return false;
 	this->_items.push_back(item);
 	return true;
@@ -48,12 +46,19 @@ bool Manager<ITEM>::add(ITEM item)
 template <typename ITEM>
 bool Manager<ITEM>::remove(ITEM item)
 {
-	if (!this->has(item))
+	typename IndexMap::iterator iter = this->_index.find(item);
+	if (iter == this->_index.end())
 		return false;
-	std::remove(
-	  this->_items.begin(),
-	  this->_items.end(),
-	  item);
+	const uint32_t position = iter->second;
+	this->_index.erase(iter);
+
+	/// Swap-and-pop
+	if (position + 1 != this->_items.size())
+	{
+		this->_items[position] = this->_items.back();
+		this->_index[this->_items[position]] = position;
+	}
+	this->_items.pop_back();
 	return true;
 }
 
@@ -61,6 +66,7 @@ template <typename ITEM>
 void Manager<ITEM>::clear()
 {
 	this->_items.clear();
+	this->_index.clear();
 }
 
 ///
@@ -78,21 +84,26 @@ Manager<std::tr1::weak_ptr<ITEM> >::~Manager()
   this->clear();
 }
 
+///
+/// @note Items are indexed by the address they point to; an expired item
+///   no longer resolves, since its address may since have been reused.
+///
 template <typename ITEM>
 typename Manager<std::tr1::weak_ptr<ITEM> >::Handle Manager<std::tr1::weak_ptr<ITEM> >::get(const Item &item)
 {
-  Handle handle = std::find_if(
-    this->_items.begin(),
-    this->_items.end(),
-    RSSD::Core::WeakPointerEqualityPredicate<ITEM>(item));
-  return handle;
+  const ITEM *key = item.lock().get();
+  if (!key)
+    return this->_items.end();
+  typename IndexMap::const_iterator iter = this->_index.find(key);
+  if ((iter == this->_index.end()) || this->_items[iter->second].expired())
+    return this->_items.end();
+  return (this->_items.begin() + iter->second);
 }
 
 template <typename ITEM>
 bool Manager<std::tr1::weak_ptr<ITEM> >::has(const Item &item)
 {
-  Handle handle = this->get(item);
-  return (handle != this->_items.end());
+  return (this->get(item) != this->_items.end());
 }
 
 template <typename ITEM>
@@ -104,25 +115,83 @@ uint32_t Manager<std::tr1::weak_ptr<ITEM> >::size() const
 template <typename ITEM>
 bool Manager<std::tr1::weak_ptr<ITEM> >::add(Item item)
 {
-  if (this->has(item))
+  const ITEM *key = item.lock().get();
+  if (!key)
     return false;
+
+  /// Reuse the position of an expired item that had the same address
+  typename IndexMap::const_iterator iter = this->_index.find(key);
+  if (iter != this->_index.end())
+  {
+    if (!this->_items[iter->second].expired())
+      return false;
+    this->_items[iter->second] = item;
+    return true;
+  }
+
+  this->_index.insert(std::make_pair(key, static_cast<uint32_t>(this->_items.size())));
   this->_items.push_back(item);
+  this->_keys.push_back(key);
   return true;
 }
 
 template <typename ITEM>
 bool Manager<std::tr1::weak_ptr<ITEM> >::remove(Item item)
 {
-  if (!this->has(item))
+  Handle handle = this->get(item);
+  if (handle == this->_items.end())
     return false;
-  this->_items.remove_if(RSSD::Core::WeakPointerEqualityPredicate<ITEM>(item));
+  this->erase(handle - this->_items.begin());
   return true;
 }
 
+///
+/// @note Removes every expired item. Returns the number removed.
+///
+template <typename ITEM>
+uint32_t Manager<std::tr1::weak_ptr<ITEM> >::cull()
+{
+  /// Local vars
+  uint32_t culled = 0;
+
+  uint32_t position = 0;
+  while (position < this->_items.size())
+  {
+    if (!this->_items[position].expired())
+    {
+      ++position;
+      continue;
+    }
+
+    /// The last item moves into this position and is checked next
+    this->erase(position);
+    ++culled;
+  }
+  return culled;
+}
+
 template <typename ITEM>
 void Manager<std::tr1::weak_ptr<ITEM> >::clear()
 {
   this->_items.clear();
+  this->_keys.clear();
+  this->_index.clear();
+}
+
+template <typename ITEM>
+void Manager<std::tr1::weak_ptr<ITEM> >::erase(const uint32_t position)
+{
+  this->_index.erase(this->_keys[position]);
+
+  /// Swap-and-pop
+  if (position + 1 != this->_items.size())
+  {
+    this->_items[position] = this->_items.back();
+    this->_keys[position] = this->_keys.back();
+    this->_index[this->_keys[position]] = position;
+  }
+  this->_items.pop_back();
+  this->_keys.pop_back();
 }
 
 ///
@@ -143,19 +212,17 @@ Manager<ITEM*>::~Manager()
 template <typename ITEM>
 typename Manager<ITEM*>::Handle Manager<ITEM*>::get(const Item *item)
 {
-	Handle handle = std::find(
-		this->_items.begin(),
-		this->_items.end(),
-		item);
-	return handle;
+	typename IndexMap::const_iterator iter = this->_index.find(item);
+	if (iter == this->_index.end())
+		return this->_items.end();
+	return (this->_items.begin() + iter->second);
 }
 
 template <typename ITEM>
 bool Manager<ITEM*>::has(const Item *item)
 {
 	if (!item) return false;
-	Handle handle = this->get(item);
-	return (handle != this->_items.end());
+	return (this->_index.find(item) != this->_index.end());
 }
 
 template <typename ITEM>
@@ -167,7 +234,9 @@ uint32_t Manager<ITEM*>::size() const
 template <typename ITEM>
 bool Manager<ITEM*>::add(Item *item)
 {
-	if (this->has(item))
+	if (!item)
+		return false;
+	if (!this->_index.insert(std::make_pair(item, static_cast<uint32_t>(this->_items.size()))).second)
 		return false;
 	this->_items.push_back(item);
 	return true;
@@ -176,9 +245,19 @@ bool Manager<ITEM*>::add(Item *item)
 template <typename ITEM>
 bool Manager<ITEM*>::remove(Item *item)
 {
-	if (!this->has(item))
+	typename IndexMap::iterator iter = this->_index.find(item);
+	if (iter == this->_index.end())
 		return false;
-	this->_items.remove(item);
+	const uint32_t position = iter->second;
+	this->_index.erase(iter);
+
+	/// Swap-and-pop
+	if (position + 1 != this->_items.size())
+	{
+		this->_items[position] = this->_items.back();
+		this->_index[this->_items[position]] = position;
+	}
+	this->_items.pop_back();
 	return true;
 }
 
@@ -193,5 +272,5 @@ void Manager<ITEM*>::clear()
 		delete item;
 	}
 	this->_items.clear();
+	this->_index.clear();
 }
-
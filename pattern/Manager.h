@@ -60,6 +60,13 @@ namespace Pattern {
 ///   not be responsible for their memory management, e.g. de-allocation.
 ///
 
+///
+/// @note Items are stored contiguously and indexed by a hash map, so add(),
+///   has(), get() and remove() are O(1) and getItems() is a linear scan.
+///   remove() moves the last item into the vacated position, so item order
+///   is not preserved and a Handle is only valid until the next add() or
+///   remove(). Items must not be added or erased through getItems().
+///   Value items must be hashable by std::tr1::hash.
 ///
 /// @todo Rethink memory ownership of Manager-derived objects.
 /// @todo Add a template specialization for shared_ptr items.
@@ -72,8 +79,9 @@ class Manager : public boost::noncopyable
 {
 	public:
 		typedef ITEM Item;
-		typedef typename std::list<Item> ItemList;
+		typedef typename std::vector<Item> ItemList;
 		typedef typename ItemList::iterator Handle;
+		typedef typename std::tr1::unordered_map<Item, uint32_t> IndexMap;
 		typedef std::tr1::shared_ptr<Manager<ITEM> > Pointer;
 
 	public:
@@ -90,6 +98,7 @@ class Manager : public boost::noncopyable
 
 	protected:
 		ItemList _items;
+		IndexMap _index; /// @note [Item] => [Position in _items]
 }; // class Manager
 
 template <typename ITEM>
@@ -97,8 +106,9 @@ class Manager<std::tr1::weak_ptr<ITEM> > : public boost::noncopyable
 {
 public:
   typedef std::tr1::weak_ptr<ITEM> Item;
-  typedef typename std::list<Item> ItemList;
+  typedef typename std::vector<Item> ItemList;
   typedef typename ItemList::iterator Handle;
+  typedef typename std::tr1::unordered_map<const ITEM*, uint32_t> IndexMap;
   typedef std::tr1::shared_ptr<Manager<Item> > Pointer;
 
 public:
@@ -111,10 +121,15 @@ public:
   virtual uint32_t size() const;
   virtual bool add(Item item);
   virtual bool remove(Item item);
+  virtual uint32_t cull();
   virtual void clear();
 
 protected:
+  void erase(const uint32_t position);
+
   ItemList _items;
+  std::vector<const ITEM*> _keys; /// @note Address each item was added with; expired items cannot be locked
+  IndexMap _index; /// @note [Address] => [Position in _items]
 };
 
 template <typename ITEM>
@@ -122,8 +137,9 @@ class Manager<ITEM*> : public boost::noncopyable
 {
 public:
   typedef ITEM Item;
-  typedef typename std::list<Item*> ItemList;
+  typedef typename std::vector<Item*> ItemList;
   typedef typename ItemList::iterator Handle;
+  typedef typename std::tr1::unordered_map<const Item*, uint32_t> IndexMap;
   typedef std::tr1::shared_ptr<Manager<ITEM*> > Pointer;
 
 public:
@@ -140,6 +156,7 @@ public:
 
 protected:
   ItemList _items;
+  IndexMap _index; /// @note [Item] => [Position in _items]
 }; // class Manager
 
 #include "Manager-inl.h"
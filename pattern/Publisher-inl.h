@@ -1,58 +1,385 @@
-template <typename T>
-bool operator ==(
-  const std::tr1::weak_ptr<typename RSSD::Core::Pattern::Publisher<T>::Subscriber> &a,
-  const std::tr1::weak_ptr<typename RSSD::Core::Pattern::Publisher<T>::Subscriber> &b)
-{
-    return a.lock() == b.lock();
-}
+///
+/// @class Publisher<>
+///
 
+///
+/// @note The stripes are placed in mReaderStorage by hand, as operator new
+///   does not honour cache-line alignment.
+///
 template <typename T>
 Publisher<T>::Publisher() :
-  mSubscriberManager(new Publisher<T>::SubscriberManager())
-{}
+  mSubscribers(new SubscriberList()),
+  mEpoch(0),
+  mHasExpired(false)
+{
+  const uintptr_t mask = Publisher<T>::CACHE_LINE_SIZE - 1;
+  this->mReaders = reinterpret_cast<ReaderCount*>((reinterpret_cast<uintptr_t>(this->mReaderStorage) + mask) & ~mask);
+  for (uint32_t stripe = 0; stripe < Publisher<T>::READER_STRIPES; ++stripe)
+  {
+    new (&this->mReaders[stripe]) ReaderCount();
+    this->mReaders[stripe].mCounts[0] = 0;
+    this->mReaders[stripe].mCounts[1] = 0;
+  }
+}
 
 template <typename T>
 Publisher<T>::~Publisher()
-{}
+{
+  delete this->mSubscribers.load();
+  for (uint32_t epoch = 0; epoch < 2; ++epoch)
+  {
+    typename std::vector<const SubscriberList*>::iterator
+      iter = this->mRetired[epoch].begin(),
+      end = this->mRetired[epoch].end();
+    for (; iter != end; ++iter)
+    {
+      delete *iter;
+    }
+  }
+}
 
 ///
 /// @ref This strategy for culling expired pointer references was informed by the following article:
 ///   http://schneide.wordpress.com/2008/12/08/observerlistener-structures-in-c-with-boosts-smart-pointers/
+/// @note Expired subscribers are skipped here and culled afterwards,
+///   unless a writer already holds the mutex.
 ///
 template <typename T>
 void Publisher<T>::publish(T &publication)
 {
-  /// @todo Re-factor to use std::for_each() algorithm
-  typename SubscriberManager::ItemList::iterator
-    iter = this->mSubscriberManager->getItems().begin(),
-    end = this->mSubscriberManager->getItems().end();
+  /// Local vars
+  bool hasExpired = false;
+
+  {
+    const ReadGuard guard(*this);
+    typename SubscriberList::const_iterator
+      iter = guard.getSubscribers().begin(),
+      end = guard.getSubscribers().end();
+    for (; iter != end; ++iter)
+    {
+      typename Subscriber::Pointer strongSubscriber = iter->mSubscriber.lock();
+      if (!strongSubscriber)
+      {
+        hasExpired = true;
+        continue;
+      }
+      strongSubscriber->onNotification(publication);
+    }
+  }
+
+  if (hasExpired) { this->mHasExpired = true; }
+  if (this->mHasExpired) { this->cull(); }
+}
+
+template <typename T>
+void Publisher<T>::defer(const T &publication)
+{
+  boost::mutex::scoped_lock lock(this->mDeferredMutex);
+  this->mDeferred.push_back(publication);
+}
+
+///
+/// @note Delivers every deferred publication, in the order deferred, to
+///   each subscriber in turn. Returns the number of publications delivered.
+///   The batch is taken out under the lock and delivered after releasing
+///   it, so concurrent flushes deliver separate batches.
+///
+template <typename T>
+uint32_t Publisher<T>::flush()
+{
+  /// Local vars
+  PublicationList batch;
+
+  if (!this->take(batch)) { return 0; }
+  {
+    const ReadGuard guard(*this);
+    this->deliver(guard.getSubscribers(), 0, guard.getSubscribers().size(), batch);
+  }
+  if (this->mHasExpired) { this->cull(); }
+  return this->release(batch);
+}
+
+///
+/// @note Like flush(), but spreads the subscribers over the workers of
+///   scheduler, which must provide parallelFor(begin, end, body) as
+///   Concurrency::Scheduler does. Subscribers then receive the same batch
+///   concurrently, which is why it is passed to them as const.
+///
+template <typename T>
+template <typename SCHEDULER>
+uint32_t Publisher<T>::flush(SCHEDULER &scheduler)
+{
+  /// Local vars
+  PublicationList batch;
+
+  if (!this->take(batch)) { return 0; }
+  {
+    const ReadGuard guard(*this);
+    scheduler.parallelFor(0, guard.getSubscribers().size(), FlushBody(*this, guard.getSubscribers(), batch));
+  }
+  if (this->mHasExpired) { this->cull(); }
+  return this->release(batch);
+}
+
+template <typename T>
+bool Publisher<T>::hasSubscriber(const Publisher<T>::Subscriber *subscriber) const
+{
+  if (!subscriber) { return false; }
+  const ReadGuard guard(*this);
+  return Publisher<T>::contains(guard.getSubscribers(), subscriber);
+}
+
+template <typename T>
+bool Publisher<T>::registerSubscriber(const typename Publisher<T>::Subscriber::Pointer &subscriber)
+{
+  if (!subscriber) { return false; }
+  {
+    boost::mutex::scoped_lock lock(this->mWriteMutex);
+    if (Publisher<T>::contains(*this->mSubscribers.load(), subscriber.get())) { return false; }
+
+    SubscriberList *subscribers = this->copy(NULL);
+    const Entry entry = { subscriber, subscriber.get() };
+    subscribers->push_back(entry);
+    this->replace(subscribers);
+  }
+  this->throttle();
+  return true;
+}
+
+template <typename T>
+bool Publisher<T>::unregisterSubscriber(const Publisher<T>::Subscriber *subscriber)
+{
+  if (!subscriber) { return false; }
+  {
+    boost::mutex::scoped_lock lock(this->mWriteMutex);
+    if (!Publisher<T>::contains(*this->mSubscribers.load(), subscriber)) { return false; }
+    this->replace(this->copy(subscriber));
+  }
+  this->throttle();
+  return true;
+}
+
+template <typename T>
+uint32_t Publisher<T>::getSubscriberCount() const
+{
+  const ReadGuard guard(*this);
+  return guard.getSubscribers().size();
+}
+
+///
+/// @note Threads are spread over the stripes round-robin on first use.
+///
+template <typename T>
+uint32_t Publisher<T>::getStripe()
+{
+  static std::atomic<uint32_t> NEXT(0);
+  static THREAD_LOCAL uint32_t STRIPE = ~0u;
+
+  if (STRIPE == ~0u) { STRIPE = NEXT.fetch_add(1) % Publisher<T>::READER_STRIPES; }
+  return STRIPE;
+}
+
+template <typename T>
+bool Publisher<T>::contains(
+  const typename Publisher<T>::SubscriberList &subscribers,
+  const typename Publisher<T>::Subscriber *subscriber)
+{
+  typename SubscriberList::const_iterator
+    iter = subscribers.begin(),
+    end = subscribers.end();
   for (; iter != end; ++iter)
   {
-    typename Subscriber::WeakPointer &weakSubscriber = *iter;
-    if (weakSubscriber.expired())
+    if ((iter->mAddress == subscriber) && !iter->mSubscriber.expired()) { return true; }
+  }
+  return false;
+}
+
+///
+/// @note Copies the current snapshot without expired subscribers or the
+///   excluded one. Must be called with mWriteMutex held.
+///
+template <typename T>
+typename Publisher<T>::SubscriberList* Publisher<T>::copy(const typename Publisher<T>::Subscriber *excluded) const
+{
+  const SubscriberList &current = *this->mSubscribers.load();
+  SubscriberList *subscribers = new SubscriberList();
+  subscribers->reserve(current.size() + 1);
+
+  typename SubscriberList::const_iterator
+    iter = current.begin(),
+    end = current.end();
+  for (; iter != end; ++iter)
+  {
+    if ((iter->mAddress == excluded) || iter->mSubscriber.expired()) { continue; }
+    subscribers->push_back(*iter);
+  }
+  return subscribers;
+}
+
+///
+/// @note Publishes a new snapshot and retires the old one. Must be called
+///   with mWriteMutex held.
+///
+template <typename T>
+void Publisher<T>::replace(const typename Publisher<T>::SubscriberList *subscribers)
+{
+  this->mHasExpired = false;
+  this->mRetired[this->mEpoch.load()].push_back(this->mSubscribers.exchange(subscribers));
+  this->reclaim();
+}
+
+///
+/// @note Readers count themselves in before loading the snapshot, so a
+///   reader that may hold a snapshot retired under the current epoch is
+///   counted under it or under the previous one. The epoch only flips once
+///   the readers of the previous epoch have drained, and a snapshot is
+///   freed once the readers of its own epoch have drained after the flip;
+///   both counts have then been zero since it was retired. New readers
+///   count in under the new epoch, so they never hold reclamation up; the
+///   retired lists only grow while a reader that started before the last
+///   flip is still running. A writer never waits, so subscribers may
+///   (un)register from within onNotification(). Must be called with
+///   mWriteMutex held.
+///
+template <typename T>
+void Publisher<T>::reclaim()
+{
+  /// Local vars
+  const uint32_t current = this->mEpoch.load();
+  const uint32_t previous = current ^ 1;
+
+  if (!this->isDrained(previous)) { return; }
+  typename std::vector<const SubscriberList*>::iterator
+    iter = this->mRetired[previous].begin(),
+    end = this->mRetired[previous].end();
+  for (; iter != end; ++iter)
+  {
+    delete *iter;
+  }
+  this->mRetired[previous].clear();
+
+  /// Send new readers to the other epoch, so that this one drains
+  if (!this->mRetired[current].empty()) { this->mEpoch.store(previous); }
+}
+
+///
+/// @note Yields until no more than RETIRED_LIMIT snapshots await
+///   reclamation. Called without mWriteMutex held, so that readers may
+///   still (un)register from within onNotification() and finish. A thread
+///   that is itself reading some publisher does not wait, as it could be
+///   the reader being waited for.
+///
+template <typename T>
+void Publisher<T>::throttle()
+{
+  if (PublisherBase::getReadDepth()) { return; }
+  while (true)
+  {
+    {
+      boost::mutex::scoped_lock lock(this->mWriteMutex);
+      if ((this->mRetired[0].size() + this->mRetired[1].size()) <= Publisher<T>::RETIRED_LIMIT) { return; }
+      this->reclaim();
+    }
+    boost::this_thread::yield();
+  }
+}
+
+template <typename T>
+bool Publisher<T>::isDrained(const uint32_t epoch) const
+{
+  for (uint32_t stripe = 0; stripe < Publisher<T>::READER_STRIPES; ++stripe)
+  {
+    if (this->mReaders[stripe].mCounts[epoch].load()) { return false; }
+  }
+  return true;
+}
+
+///
+/// @note Moves the deferred publications into batch, and the spare storage
+///   into the deferred queue; false if there are none.
+///
+template <typename T>
+bool Publisher<T>::take(typename Publisher<T>::PublicationList &batch)
+{
+  boost::mutex::scoped_lock lock(this->mDeferredMutex);
+  if (this->mDeferred.empty()) { return false; }
+  batch.swap(this->mDeferred);
+  this->mDeferred.swap(this->mSpare);
+  return true;
+}
+
+///
+/// @note Keeps the storage of a delivered batch for the next take(), so
+///   that steady-state flushes do not allocate. Returns the batch size.
+///
+template <typename T>
+uint32_t Publisher<T>::release(typename Publisher<T>::PublicationList &batch)
+{
+  /// Local vars
+  const uint32_t count = batch.size();
+
+  batch.clear();
+  boost::mutex::scoped_lock lock(this->mDeferredMutex);
+  if (batch.capacity() > this->mSpare.capacity()) { this->mSpare.swap(batch); }
+  return count;
+}
+
+template <typename T>
+void Publisher<T>::deliver(
+  const typename Publisher<T>::SubscriberList &subscribers,
+  const size_t first,
+  const size_t last,
+  const typename Publisher<T>::PublicationList &publications)
+{
+  for (size_t index = first; index != last; ++index)
+  {
+    typename Subscriber::Pointer strongSubscriber = subscribers[index].mSubscriber.lock();
+    if (!strongSubscriber)
     {
-      iter = this->mSubscriberManager->getItems().erase(iter);
+      this->mHasExpired = true;
       continue;
     }
-    typename Subscriber::Pointer strongSubscriber = weakSubscriber.lock();
-    strongSubscriber->onNotification(publication);
+    strongSubscriber->onNotifications(&publications[0], publications.size());
   }
 }
 
 template <typename T>
-bool Publisher<T>::hasSubscriber(Publisher<T>::Subscriber *subscriber)
+void Publisher<T>::cull()
 {
-  return this->mSubscriberManager->has(Subscriber::WeakPointer(subscriber));
+  boost::mutex::scoped_lock lock(this->mWriteMutex, boost::try_to_lock);
+  if (!lock.owns_lock() || !this->mHasExpired) { return; }
+  this->replace(this->copy(NULL));
 }
 
+///
+/// @class Publisher<>::ReadGuard
+///
+
+///
+/// @note Counts in under the current epoch. If a writer flipped it in the
+///   meantime, the writer may already have found the old epoch drained, so
+///   the reader counts in again under the new one.
+///
 template <typename T>
-bool Publisher<T>::registerSubscriber(Publisher<T>::Subscriber *subscriber)
+Publisher<T>::ReadGuard::ReadGuard(const Publisher<T> &publisher) :
+  mReaders(publisher.mReaders[Publisher<T>::getStripe()]),
+  mEpoch(publisher.mEpoch.load())
 {
-  return this->mSubscriberManager->add(Subscriber::WeakPointer(subscriber));
+  ++PublisherBase::getReadDepth();
+  while (true)
+  {
+    ++this->mReaders.mCounts[this->mEpoch];
+    const uint32_t epoch = publisher.mEpoch.load();
+    if (epoch == this->mEpoch) { break; }
+    --this->mReaders.mCounts[this->mEpoch];
+    this->mEpoch = epoch;
+  }
+  this->mSubscribers = publisher.mSubscribers.load();
 }
 
 template <typename T>
-bool Publisher<T>::unregisterSubscriber(Publisher<T>::Subscriber *subscriber)
+Publisher<T>::ReadGuard::~ReadGuard()
 {
-  return this->mSubscriberManager->remove(Subscriber::WeakPointer(subscriber));
+  --this->mReaders.mCounts[this->mEpoch];
+  --PublisherBase::getReadDepth();
 }
@@ -34,8 +34,6 @@
 #define RSSD_CORE_PATTERN_PUBLISHER_H
 
 #include "System"
-#include "Manager.h"
-#include "system/Memory.h"
 
 namespace RSSD {
 namespace Core {
@@ -43,9 +41,44 @@ namespace Pattern {
 
 ///
 /// @note typename T The object with which to update registered subscribers.
+/// @note Subscribers are held weakly in an immutable snapshot. publish()
+///   reads the current snapshot without taking a lock, so it may be called
+///   from any number of threads at once. registerSubscriber() and
+///   unregisterSubscriber() copy the snapshot under a writer mutex and swap
+///   the copy in; expired subscribers are dropped whenever a copy is made.
+///   A replaced snapshot is freed once no publish() may still be reading
+///   it, which is tracked by reader counts striped across cache lines.
+///   Readers count themselves in under one of two epochs, and writers
+///   flip the epoch, so snapshots are freed as soon as the readers that
+///   started before a flip have finished, however busy the publisher is.
+///   Once RETIRED_LIMIT snapshots await reclamation, writers yield until
+///   those readers have finished.
+/// @note defer() queues a copy of a publication instead of delivering it.
+///   flush() then hands each subscriber the whole batch in a single
+///   onNotifications() call, so the per-subscriber costs (the virtual call
+///   and locking the weak pointer) are paid once per batch rather than
+///   once per publication. The batch is read-only, as subscribers may
+///   receive it concurrently, and no lock is held while it is delivered,
+///   so subscribers may defer() and flush() from within the call.
 ///
+///
+/// @brief State shared by publishers of every type.
+///
+class PublisherBase : public boost::noncopyable
+{
+protected:
+  ///
+  /// @note Publications this thread is reading, in any publisher.
+  ///
+  static FORCE_INLINE uint32_t& getReadDepth()
+  {
+    static THREAD_LOCAL uint32_t DEPTH = 0;
+    return DEPTH;
+  }
+}; /// class PublisherBase
+
 template <typename T>
-class Publisher
+class Publisher : public PublisherBase
 {
 public:
   /// @todo Consider if the subscriber notification callback can be
@@ -60,19 +93,103 @@ public:
 
 	  virtual ~Subscriber() {}
 	  virtual void onNotification(T &publication) = 0;
+
+	  /// @note Receives a flushed batch; override to handle it as a span.
+	  ///   By default, each publication is copied and passed to onNotification().
+	  virtual void onNotifications(const T *publications, const size_t count)
+	  {
+	    for (size_t index = 0; index < count; ++index)
+	    {
+	      T publication(publications[index]);
+	      this->onNotification(publication);
+	    }
+	  }
 	}; // class Subscriber
 
 	Publisher();
 	virtual ~Publisher();
 	void publish(T &publication);
-	bool hasSubscriber(Subscriber *subscriber);
-	bool registerSubscriber(Subscriber *subscriber);
-	bool unregisterSubscriber(Subscriber *subscriber);
+	void defer(const T &publication);
+	uint32_t flush();
+	template <typename SCHEDULER> uint32_t flush(SCHEDULER &scheduler);
+	bool hasSubscriber(const Subscriber *subscriber) const;
+	bool registerSubscriber(const typename Subscriber::Pointer &subscriber);
+	bool unregisterSubscriber(const Subscriber *subscriber);
+	uint32_t getSubscriberCount() const;
 
 protected:
-	typedef Pattern::Manager<typename Publisher<T>::Subscriber::WeakPointer> SubscriberManager;
+  struct Entry
+  {
+    typename Subscriber::WeakPointer mSubscriber;
+    const Subscriber *mAddress; /// @note Compared without locking mSubscriber
+  }; /// struct Entry
+
+  typedef std::vector<Entry> SubscriberList;
+
+  struct ReaderCount
+  {
+    std::atomic<uint32_t> mCounts[2]; /// @note [Epoch] => Readers
+    char mPadding[64 - 2 * sizeof(std::atomic<uint32_t>)]; /// @note Keep stripes on separate cache lines.
+  }; /// struct ReaderCount
+
+  typedef std::vector<T> PublicationList;
 
-	typename SubscriberManager::Pointer mSubscriberManager;
+  ///
+  /// @brief Delivers a batch to a range of subscribers; one parallelFor() body.
+  ///
+  struct FlushBody
+  {
+    FlushBody(Publisher<T> &publisher, const SubscriberList &subscribers, const PublicationList &publications) :
+      mPublisher(publisher), mSubscribers(subscribers), mPublications(publications) {}
+    void operator()(const size_t first, const size_t last) const { this->mPublisher.deliver(this->mSubscribers, first, last, this->mPublications); }
+
+    Publisher<T> &mPublisher;
+    const SubscriberList &mSubscribers;
+    const PublicationList &mPublications;
+  }; /// struct FlushBody
+
+  ///
+  /// @brief Pins the current snapshot for the lifetime of the guard.
+  ///
+  class ReadGuard : public boost::noncopyable
+  {
+  public:
+    ReadGuard(const Publisher<T> &publisher);
+    ~ReadGuard();
+    FORCE_INLINE const SubscriberList& getSubscribers() const { return *this->mSubscribers; }
+
+  protected:
+    ReaderCount &mReaders;
+    uint32_t mEpoch;
+    const SubscriberList *mSubscribers;
+  }; /// class ReadGuard
+
+  static const uint32_t READER_STRIPES = 16;
+  static const size_t CACHE_LINE_SIZE = 64;
+  static const size_t RETIRED_LIMIT = 64; /// @note Snapshots awaiting reclamation before writers yield
+
+  static uint32_t getStripe();
+  static bool contains(const SubscriberList &subscribers, const Subscriber *subscriber);
+  SubscriberList* copy(const Subscriber *excluded) const;
+  void replace(const SubscriberList *subscribers);
+  void reclaim();
+  void throttle();
+  bool isDrained(const uint32_t epoch) const;
+  void cull();
+  bool take(PublicationList &batch);
+  uint32_t release(PublicationList &batch);
+  void deliver(const SubscriberList &subscribers, const size_t first, const size_t last, const PublicationList &publications);
+
+  std::atomic<const SubscriberList*> mSubscribers; /// @note Current snapshot; never modified once published
+  char mReaderStorage[(READER_STRIPES + 1) * sizeof(ReaderCount)]; /// @note One spare stripe, so that mReaders can start on a cache line
+  ReaderCount *mReaders; /// @note READER_STRIPES stripes, cache-line aligned within mReaderStorage
+  std::atomic<uint32_t> mEpoch; /// @note Epoch new readers count themselves in under
+  std::vector<const SubscriberList*> mRetired[2]; /// @note [Epoch] => Replaced snapshots, retired while it was current
+  std::atomic<bool> mHasExpired; /// @note A publish() has met an expired subscriber
+  boost::mutex mWriteMutex;
+  PublicationList mDeferred; /// @note Queued by defer()
+  PublicationList mSpare; /// @note Storage of a delivered batch, kept for the next take()
+  boost::mutex mDeferredMutex;
 }; // class Publisher
 
 ///
@@ -85,9 +202,4 @@ protected:
 } // namespace Core
 } // namespace RSSD
 
-template <typename T>
-bool operator ==(
-    const std::tr1::weak_ptr<typename RSSD::Core::Pattern::Publisher<T>::Subscriber>& a,
-    const std::tr1::weak_ptr<typename RSSD::Core::Pattern::Publisher<T>::Subscriber>& b);
-
 #endif // RSSD_CORE_PATTERN_PUBLISHER_H
@@ -0,0 +1,102 @@
+///
+/// @class Signal<>
+///
+
+template <typename T>
+Signal<T>::Signal() :
+  mSelf(new Signal<T>*(this)),
+  mDepth(0)
+{
+}
+
+///
+/// @note Outstanding connections, scoped ones included, see the Signal
+///   as gone from here on.
+///
+template <typename T>
+Signal<T>::~Signal()
+{
+  *this->mSelf = NULL;
+}
+
+template <typename T>
+typename Signal<T>::Connection Signal<T>::connect(const typename Signal<T>::DelegateType &delegate)
+{
+  if (!delegate.isBound()) { return Connection(); }
+  const Handle handle = this->mDelegates.add(delegate);
+  if (handle == SlotManager<DelegateType>::INVALID) { return Connection(); }
+  return Connection(this->mSelf, handle);
+}
+
+///
+/// @note During emit() the delegate is only unbound, so that the scan is
+///   not disturbed; it is removed once the outermost emit() returns.
+///
+template <typename T>
+bool Signal<T>::disconnect(const typename Signal<T>::Connection &connection)
+{
+  DelegateType *delegate = this->mDelegates.get(connection.getHandle());
+  if (!delegate || !delegate->isBound()) { return false; }
+  if (!this->mDepth) { return this->mDelegates.remove(connection.getHandle()); }
+
+  *delegate = DelegateType();
+  this->mDisconnected.push_back(connection.getHandle());
+  return true;
+}
+
+template <typename T>
+bool Signal<T>::isConnected(const typename Signal<T>::Connection &connection) const
+{
+  const DelegateType *delegate = this->mDelegates.get(connection.getHandle());
+  return (delegate && delegate->isBound());
+}
+
+template <typename T>
+void Signal<T>::emit(T &value)
+{
+  /// Local vars; delegates connected from here on are left to the next emit()
+  const uint32_t count = this->mDelegates.size();
+  EmitScope scope(*this);
+
+  for (uint32_t index = 0; index < count; ++index)
+  {
+    /// Copied, as a delegate may connect others and so move the storage
+    const DelegateType delegate = this->mDelegates.getItems()[index];
+    if (delegate.isBound()) { delegate(value); }
+  }
+}
+
+///
+/// @note Removes the delegates disconnected during emit(); called once the
+///   outermost emit() is left, by return or by exception.
+///
+template <typename T>
+void Signal<T>::purge()
+{
+  typename std::vector<Handle>::const_iterator
+    iter = this->mDisconnected.begin(),
+    end = this->mDisconnected.end();
+  for (; iter != end; ++iter)
+  {
+    this->mDelegates.remove(*iter);
+  }
+  this->mDisconnected.clear();
+}
+
+template <typename T>
+void Signal<T>::clear()
+{
+  if (!this->mDepth)
+  {
+    this->mDelegates.clear();
+    return;
+  }
+
+  for (uint32_t position = 0; position < this->mDelegates.size(); ++position)
+  {
+    DelegateType &delegate = this->mDelegates.getItems()[position];
+    if (!delegate.isBound()) { continue; }
+    delegate = DelegateType();
+    this->mDisconnected.push_back(this->mDelegates.getHandle(position));
+  }
+}
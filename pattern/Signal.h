@@ -0,0 +1,138 @@
+///
+/// @file Signal.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by Royal Society of Secret Design
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+/// 		this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+/// 		this list of conditions and the following disclaimer in the documentation
+/// 		and/or other materials provided with the distribution.
+///    * Neither the name of Royal Society of Secret Design nor the names of its
+/// 		contributors may be used to endorse or promote products derived from
+/// 		this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+#ifndef RSSD_CORE_PATTERN_SIGNAL_H
+#define RSSD_CORE_PATTERN_SIGNAL_H
+
+#include "System"
+#include "Delegate.h"
+#include "SlotManager.h"
+
+namespace RSSD {
+namespace Core {
+namespace Pattern {
+
+///
+/// @brief Calls every connected Delegate with each emitted value.
+/// @note Delegates are stored contiguously, so emit() is a linear scan of
+///   direct calls. Connections are explicit: connect() returns a
+///   Connection that stays valid until disconnected, and a delegate's
+///   object must outlive its connection (or use a ScopedConnection).
+///   Connections share a reference to their Signal that is cleared when
+///   it is destroyed, so a connection that outlives its Signal is simply
+///   no longer connected. Delegates may connect or
+///   disconnect during emit(); new delegates are first called by the next
+///   emit(), and disconnected ones are not called again. Not thread-safe;
+///   use Publisher to notify from several threads.
+///
+template <typename T>
+class Signal : public boost::noncopyable
+{
+public:
+  typedef Pattern::Delegate<T> DelegateType;
+  typedef typename SlotManager<DelegateType>::Handle Handle;
+  typedef SharedPointer<Signal<T>*> Reference; /// @note Points to the Signal while it is alive, and to NULL after
+
+  class Connection
+  {
+  public:
+    Connection() : mHandle(SlotManager<DelegateType>::INVALID) {}
+    Connection(const Reference &signal, const Handle handle) : mSignal(signal), mHandle(handle) {}
+    FORCE_INLINE Signal<T>* getSignal() const { return this->mSignal ? *this->mSignal : NULL; }
+    FORCE_INLINE bool isConnected() const { Signal<T> *signal = this->getSignal(); return (signal && signal->isConnected(*this)); }
+    FORCE_INLINE bool disconnect() { Signal<T> *signal = this->getSignal(); return (signal && signal->disconnect(*this)); }
+    FORCE_INLINE Handle getHandle() const { return this->mHandle; }
+
+  protected:
+    Reference mSignal;
+    Handle mHandle;
+  }; /// class Connection
+
+  ///
+  /// @brief Disconnects on destruction; for objects that own their connection.
+  ///
+  class ScopedConnection : public Connection, public boost::noncopyable
+  {
+  public:
+    ScopedConnection() {}
+    ScopedConnection(const Connection &connection) : Connection(connection) {}
+    ~ScopedConnection() { this->disconnect(); }
+    FORCE_INLINE ScopedConnection& operator =(const Connection &connection)
+    {
+      this->disconnect();
+      Connection::operator =(connection);
+      return *this;
+    }
+  }; /// class ScopedConnection
+
+  Signal();
+  ~Signal();
+  Connection connect(const DelegateType &delegate);
+  bool disconnect(const Connection &connection);
+  bool isConnected(const Connection &connection) const;
+  void emit(T &value);
+  FORCE_INLINE void operator()(T &value) { this->emit(value); }
+  FORCE_INLINE uint32_t size() const { return this->mDelegates.size(); }
+  void clear();
+
+protected:
+  ///
+  /// @brief Tracks the nesting of emit(); the outermost one removes the
+  ///   delegates disconnected meanwhile, even if a delegate threw.
+  ///
+  struct EmitScope
+  {
+    EmitScope(Signal<T> &signal) : mSignal(signal) { ++signal.mDepth; }
+    ~EmitScope() { if (!--this->mSignal.mDepth) { this->mSignal.purge(); } }
+
+    Signal<T> &mSignal;
+  }; /// struct EmitScope
+
+  void purge();
+
+  Reference mSelf; /// @note Shared with every Connection; cleared on destruction
+  SlotManager<DelegateType> mDelegates;
+  std::vector<Handle> mDisconnected; /// @note Removed once the outermost emit() returns
+  uint32_t mDepth; /// @note Nesting depth of emit(); see EmitScope
+}; /// class Signal
+
+///
+/// Includes
+///
+
+#include "Signal-inl.h"
+
+} /// namespace Pattern
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_CORE_PATTERN_SIGNAL_H
@@ -0,0 +1,122 @@
+///
+/// @class template <typename T> SlotManager
+///
+
+template <typename ITEM>
+SlotManager<ITEM>::SlotManager() :
+  mItems(true)
+{
+}
+
+template <typename ITEM>
+SlotManager<ITEM>::~SlotManager()
+{
+  this->clear();
+}
+
+template <typename ITEM>
+ITEM* SlotManager<ITEM>::get(const Handle handle)
+{
+  const size_t position = this->resolve(handle);
+  return (position == SlotManager<ITEM>::NPOS) ? NULL : &this->mItems[position];
+}
+
+template <typename ITEM>
+const ITEM* SlotManager<ITEM>::get(const Handle handle) const
+{
+  const size_t position = this->resolve(handle);
+  return (position == SlotManager<ITEM>::NPOS) ? NULL : &this->mItems[position];
+}
+
+template <typename ITEM>
+bool SlotManager<ITEM>::has(const Handle handle) const
+{
+  return (this->resolve(handle) != SlotManager<ITEM>::NPOS);
+}
+
+template <typename ITEM>
+uint32_t SlotManager<ITEM>::size() const
+{
+  return this->mItems.size();
+}
+
+///
+/// @note Returns INVALID once all 2^INDEX_BITS slots are live or retired.
+///
+template <typename ITEM>
+typename SlotManager<ITEM>::Handle SlotManager<ITEM>::add(const ITEM &item)
+{
+  /// Local vars
+  uint32_t index = 0;
+
+  if (!this->mFreeSlots.empty())
+  {
+    /// Reuse the slot freed longest ago; its generation was bumped when it was freed
+    index = this->mFreeSlots.front();
+    this->mFreeSlots.pop_front();
+  }
+  else
+  {
+    if (this->mGenerations.size() > SlotManager<ITEM>::INDEX_MASK)
+      return SlotManager<ITEM>::INVALID;
+    index = this->mGenerations.size();
+    this->mGenerations.push_back(1);
+  }
+
+  this->mItems.insert(index, item);
+  return ((this->mGenerations[index] << SlotManager<ITEM>::INDEX_BITS) | index);
+}
+
+template <typename ITEM>
+bool SlotManager<ITEM>::remove(const Handle handle)
+{
+  if (this->resolve(handle) == SlotManager<ITEM>::NPOS)
+    return false;
+
+  /// Swap-and-pop; the moved item keeps its slot and so its handle
+  const uint32_t index = SlotManager<ITEM>::getIndex(handle);
+  this->mItems.erase(index);
+
+  /// Retire the handle; a slot that has used up its generations is never reused
+  uint32_t &generation = this->mGenerations[index];
+  if (generation == SlotManager<ITEM>::GENERATION_MASK)
+    return true;
+  ++generation;
+  this->mFreeSlots.push_back(index);
+  return true;
+}
+
+///
+/// @note Invalidates every handle issued so far, without reusing any of
+///   their generations in the slots that are kept.
+///
+template <typename ITEM>
+void SlotManager<ITEM>::clear()
+{
+  while (!this->mItems.empty())
+  {
+    this->remove(this->getHandle(this->mItems.size() - 1));
+  }
+}
+
+template <typename ITEM>
+typename SlotManager<ITEM>::Handle SlotManager<ITEM>::getHandle(const uint32_t position) const
+{
+  if (position >= this->mItems.size())
+    return SlotManager<ITEM>::INVALID;
+  const uint32_t index = this->mItems.getKey(position);
+  return ((this->mGenerations[index] << SlotManager<ITEM>::INDEX_BITS) | index);
+}
+
+///
+/// @note A free or retired slot is not in the map, so its handles no
+///   longer resolve even while the generation still matches.
+///
+template <typename ITEM>
+size_t SlotManager<ITEM>::resolve(const Handle handle) const
+{
+  const uint32_t index = SlotManager<ITEM>::getIndex(handle);
+  if ((index >= this->mGenerations.size()) || (this->mGenerations[index] != SlotManager<ITEM>::getGeneration(handle)))
+    return SlotManager<ITEM>::NPOS;
+  return this->mItems.getPosition(index);
+}
@@ -0,0 +1,106 @@
+///
+/// @file SlotManager.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by Royal Society of Secret Design
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+/// 		this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+/// 		this list of conditions and the following disclaimer in the documentation
+/// 		and/or other materials provided with the distribution.
+///    * Neither the name of Royal Society of Secret Design nor the names of its
+/// 		contributors may be used to endorse or promote products derived from
+/// 		this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+#ifndef RSSD_CORE_PATTERN_SLOTMANAGER_H
+#define RSSD_CORE_PATTERN_SLOTMANAGER_H
+
+#include <deque>
+#include "System"
+#include "SlotMap.h"
+
+namespace RSSD {
+namespace Core {
+namespace Pattern {
+
+///
+/// @brief Manager variant that identifies items by generational handles.
+/// @note A Handle packs a slot index (low INDEX_BITS) and the slot's
+///   generation (high bits) into 32 bits, so it can be stored, compared
+///   and sent in packets or event records in place of a pointer. Removing
+///   an item bumps its slot's generation, so stale handles fail to resolve
+///   rather than aliasing a later item. Freed slots are reused oldest
+///   first, and a slot whose generation is exhausted is retired rather
+///   than wrapped, so no handle is ever issued twice. Items are stored
+///   contiguously in a SlotMap keyed by slot index and move on removal
+///   (swap-and-pop), but their handles stay the same. Lookup, add() and
+///   remove() are O(1). Not thread-safe.
+///
+template <typename ITEM>
+class SlotManager : public boost::noncopyable
+{
+public:
+  typedef ITEM Item;
+  typedef typename std::vector<Item> ItemList;
+  typedef uint32_t Handle;
+  typedef std::tr1::shared_ptr<SlotManager<ITEM> > Pointer;
+
+  static const uint32_t INDEX_BITS = 20;
+  static const uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+  static const uint32_t GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+  static const Handle INVALID = 0; /// @note Generations start at 1, so no live handle is zero
+
+  SlotManager();
+  virtual ~SlotManager();
+  virtual inline ItemList& getItems() { return this->mItems.getValues(); }
+  virtual inline const ItemList& getItems() const { return this->mItems.getValues(); }
+  virtual ITEM* get(const Handle handle);
+  virtual const ITEM* get(const Handle handle) const;
+  virtual bool has(const Handle handle) const;
+  virtual uint32_t size() const;
+  virtual Handle add(const ITEM &item);
+  virtual bool remove(const Handle handle);
+  virtual void clear();
+  Handle getHandle(const uint32_t position) const;
+  static FORCE_INLINE uint32_t getIndex(const Handle handle) { return (handle & INDEX_MASK); }
+  static FORCE_INLINE uint32_t getGeneration(const Handle handle) { return (handle >> INDEX_BITS); }
+
+protected:
+  static const size_t NPOS = SlotMap<ITEM>::NPOS;
+
+  size_t resolve(const Handle handle) const;
+
+  SlotMap<ITEM> mItems; /// @note [Slot index] => [Item]
+  std::vector<uint32_t> mGenerations; /// @note [Slot index] => Generation of its live or next handle
+  std::deque<uint32_t> mFreeSlots; /// @note Oldest first; retired slots are left out
+}; /// class SlotManager
+
+///
+/// Includes
+///
+
+#include "SlotManager-inl.h"
+
+} /// namespace Pattern
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_CORE_PATTERN_SLOTMANAGER_H
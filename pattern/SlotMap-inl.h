@@ -0,0 +1,148 @@
+///
+/// @class SlotMap
+///
+
+template <typename VALUE>
+SlotMap<VALUE>::SlotMap(const bool isKeepingPages) :
+  mGeneration(0),
+  mIsKeepingPages(isKeepingPages)
+{
+
+}
+
+template <typename VALUE>
+SlotMap<VALUE>::~SlotMap()
+{
+  this->clear();
+}
+
+///
+/// @note Returns an invalid handle if the key is already present.
+///
+template <typename VALUE>
+typename SlotMap<VALUE>::Handle SlotMap<VALUE>::insert(const KeyType key, const VALUE &value)
+{
+  /// Local vars
+  const uint32_t pageIndex = key >> SlotMap<VALUE>::PAGE_BITS;
+
+  if (pageIndex >= this->mPages.size()) { this->mPages.resize(pageIndex + 1, NULL); }
+  Page *&page = this->mPages[pageIndex];
+  if (!page) { page = new Page(); }
+
+  Slot &slot = page->mSlots[key & (SlotMap<VALUE>::PAGE_SIZE - 1)];
+  if (slot.mGeneration) { return Handle(); }
+
+  /// Generation zero marks a vacant slot
+  if (!++this->mGeneration) { ++this->mGeneration; }
+  slot.mPosition = this->mValues.size();
+  slot.mGeneration = this->mGeneration;
+  ++page->mCount;
+  this->mValues.push_back(value);
+  this->mKeys.push_back(key);
+  return Handle(key, slot.mGeneration);
+}
+
+///
+/// @note Moves the last value into the erased position.
+///
+template <typename VALUE>
+bool SlotMap<VALUE>::erase(const KeyType key)
+{
+  /// Local vars
+  const uint32_t pageIndex = key >> SlotMap<VALUE>::PAGE_BITS;
+
+  if (pageIndex >= this->mPages.size() || !this->mPages[pageIndex]) { return false; }
+  Page *&page = this->mPages[pageIndex];
+  Slot &slot = page->mSlots[key & (SlotMap<VALUE>::PAGE_SIZE - 1)];
+  if (!slot.mGeneration) { return false; }
+
+  /// Swap and pop
+  const uint32_t position = slot.mPosition;
+  const uint32_t last = this->mValues.size() - 1;
+  if (position != last)
+  {
+    std::swap(this->mValues[position], this->mValues[last]);
+    this->mKeys[position] = this->mKeys[last];
+    const KeyType moved = this->mKeys[position];
+    this->mPages[moved >> SlotMap<VALUE>::PAGE_BITS]->mSlots[moved & (SlotMap<VALUE>::PAGE_SIZE - 1)].mPosition = position;
+  }
+  this->mValues.pop_back();
+  this->mKeys.pop_back();
+
+  slot.mGeneration = 0;
+  if (!--page->mCount && !this->mIsKeepingPages)
+  {
+    delete page;
+    page = NULL;
+  }
+  return true;
+}
+
+template <typename VALUE>
+void SlotMap<VALUE>::clear()
+{
+  typename std::vector<Page*>::iterator
+    iter = this->mPages.begin(),
+    end = this->mPages.end();
+  for (; iter != end; ++iter)
+  {
+    delete *iter;
+  }
+  this->mPages.clear();
+  this->mValues.clear();
+  this->mKeys.clear();
+}
+
+template <typename VALUE>
+void SlotMap<VALUE>::reserve(const size_t count)
+{
+  this->mValues.reserve(count);
+  this->mKeys.reserve(count);
+}
+
+template <typename VALUE>
+VALUE* SlotMap<VALUE>::find(const KeyType key)
+{
+  const Slot *slot = this->getSlot(key);
+  return slot ? &this->mValues[slot->mPosition] : NULL;
+}
+
+template <typename VALUE>
+const VALUE* SlotMap<VALUE>::find(const KeyType key) const
+{
+  const Slot *slot = this->getSlot(key);
+  return slot ? &this->mValues[slot->mPosition] : NULL;
+}
+
+template <typename VALUE>
+VALUE* SlotMap<VALUE>::find(const Handle &handle)
+{
+  const Slot *slot = this->getSlot(handle.mKey);
+  if (!slot || (slot->mGeneration != handle.mGeneration)) { return NULL; }
+  return &this->mValues[slot->mPosition];
+}
+
+template <typename VALUE>
+typename SlotMap<VALUE>::Handle SlotMap<VALUE>::getHandle(const KeyType key) const
+{
+  const Slot *slot = this->getSlot(key);
+  return slot ? Handle(key, slot->mGeneration) : Handle();
+}
+
+template <typename VALUE>
+size_t SlotMap<VALUE>::getPosition(const KeyType key) const
+{
+  const Slot *slot = this->getSlot(key);
+  return slot ? slot->mPosition : SlotMap<VALUE>::NPOS;
+}
+
+template <typename VALUE>
+const typename SlotMap<VALUE>::Slot* SlotMap<VALUE>::getSlot(const KeyType key) const
+{
+  /// Local vars
+  const uint32_t pageIndex = key >> SlotMap<VALUE>::PAGE_BITS;
+
+  if (pageIndex >= this->mPages.size() || !this->mPages[pageIndex]) { return NULL; }
+  const Slot &slot = this->mPages[pageIndex]->mSlots[key & (SlotMap<VALUE>::PAGE_SIZE - 1)];
+  return slot.mGeneration ? &slot : NULL;
+}
@@ -0,0 +1,134 @@
+///
+/// @file SlotMap.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by The Secret Design Collective
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+///     this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+///     this list of conditions and the following disclaimer in the documentation
+///     and/or other materials provided with the distribution.
+///    * Neither the name of The Secret Design Collective nor the names of its
+///     contributors may be used to endorse or promote products derived from
+///     this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+
+#ifndef RSSD_CORE_PATTERN_SLOTMAP_H
+#define RSSD_CORE_PATTERN_SLOTMAP_H
+
+#include <cstring>
+#include "System"
+
+namespace RSSD {
+namespace Core {
+namespace Pattern {
+
+///
+/// @brief Dense map from 32-bit keys (task IDs, slot indices) to values.
+/// @note Values live contiguously in insertion order, apart from swap-and-pop
+///   removal, so iteration is a linear scan. Keys resolve through a paged
+///   sparse index in O(1). Pages are allocated on first use and, unless
+///   the map keeps its pages, freed once empty, so memory follows the live
+///   key range rather than the largest key ever seen. Each insertion stamps its slot with a fresh generation;
+///   a Handle taken before the key was erased (and possibly reinserted)
+///   no longer resolves. Not thread-safe.
+///
+template <typename VALUE>
+class SlotMap : boost::noncopyable
+{
+public:
+  typedef uint32_t KeyType;
+  typedef VALUE ValueType;
+  typedef typename std::vector<VALUE>::iterator iterator;
+  typedef typename std::vector<VALUE>::const_iterator const_iterator;
+
+  struct Handle
+  {
+    Handle(const KeyType key = 0, const uint32_t generation = 0) : mKey(key), mGeneration(generation) {}
+    FORCE_INLINE bool isValid() const { return (this->mGeneration != 0); }
+
+    KeyType mKey;
+    uint32_t mGeneration; /// @note Zero for an invalid handle
+  }; /// struct Handle
+
+  SlotMap(const bool isKeepingPages = false); /// @note Kept pages spare churn on a small, dense key range
+  ~SlotMap();
+  Handle insert(const KeyType key, const VALUE &value = VALUE());
+  bool erase(const KeyType key);
+  void clear();
+  void reserve(const size_t count);
+  VALUE* find(const KeyType key);
+  const VALUE* find(const KeyType key) const;
+  VALUE* find(const Handle &handle);
+  Handle getHandle(const KeyType key) const;
+  size_t getPosition(const KeyType key) const;
+  FORCE_INLINE bool contains(const KeyType key) const { return (this->getPosition(key) != SlotMap<VALUE>::NPOS); }
+  FORCE_INLINE KeyType getKey(const size_t position) const { return this->mKeys[position]; }
+  FORCE_INLINE std::vector<VALUE>& getValues() { return this->mValues; }
+  FORCE_INLINE const std::vector<VALUE>& getValues() const { return this->mValues; }
+  FORCE_INLINE VALUE& operator[](const size_t position) { return this->mValues[position]; }
+  FORCE_INLINE const VALUE& operator[](const size_t position) const { return this->mValues[position]; }
+  FORCE_INLINE size_t size() const { return this->mValues.size(); }
+  FORCE_INLINE bool empty() const { return this->mValues.empty(); }
+  FORCE_INLINE iterator begin() { return this->mValues.begin(); }
+  FORCE_INLINE iterator end() { return this->mValues.end(); }
+  FORCE_INLINE const_iterator begin() const { return this->mValues.begin(); }
+  FORCE_INLINE const_iterator end() const { return this->mValues.end(); }
+
+  static const uint32_t PAGE_BITS = 10;
+  static const uint32_t PAGE_SIZE = 1 << PAGE_BITS;
+  static const size_t NPOS = static_cast<size_t>(-1);
+
+protected:
+  struct Slot
+  {
+    uint32_t mPosition; /// @note Index into the dense arrays
+    uint32_t mGeneration; /// @note Zero while vacant
+  }; /// struct Slot
+
+  struct Page
+  {
+    Page() : mCount(0) { std::memset(this->mSlots, 0, sizeof(this->mSlots)); }
+
+    uint32_t mCount; /// @note Occupied slots
+    Slot mSlots[PAGE_SIZE];
+  }; /// struct Page
+
+  const Slot* getSlot(const KeyType key) const;
+
+  std::vector<Page*> mPages;
+  std::vector<VALUE> mValues;
+  std::vector<KeyType> mKeys; /// @note Key of each dense value
+  uint32_t mGeneration;
+  bool mIsKeepingPages;
+}; /// class SlotMap
+
+///
+/// Includes
+///
+
+#include "SlotMap-inl.h"
+
+} /// namespace Pattern
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_CORE_PATTERN_SLOTMAP_H
@@ -109,6 +109,22 @@ namespace Core {
 #define RSSD_MICROSOFT_THREADS 1
 #endif
 
+///
+/// Concurrency
+///
+
+/// @note Set RSSD_NATIVE_SCHEDULER to 1 to build Concurrency::BasicScheduler
+///   on the native work-stealing backend instead of Intel TBB.
+#if !defined(RSSD_NATIVE_SCHEDULER)
+#define RSSD_NATIVE_SCHEDULER 0
+#endif
+
+/// @note Set RSSD_TRACE_SCHEDULER to 1 to record every task execution into
+///   the scheduler's Tracer. When 0, the instrumentation compiles out.
+#if !defined(RSSD_TRACE_SCHEDULER)
+#define RSSD_TRACE_SCHEDULER 0
+#endif
+
 }  // namespace Core
 }  // namespace RSSD
 
@@ -57,6 +57,7 @@
 #include <thread>
 #include <tr1/memory>
 #include <tr1/functional>
+#include <tr1/unordered_map>
 
 #include <boost/thread.hpp>
 #include <boost/thread/barrier.hpp>
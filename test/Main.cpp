@@ -0,0 +1,10 @@
+#include "System"
+#include "test/concurrency/ConcurrencyMain.h"
+#include "test/pattern/PatternMain.h"
+
+int main(int argc, char **argv)
+{
+  int result = RSSD::Core::Pattern::PatternMain(argc, argv);
+  result += RSSD::Core::Concurrency::ConcurrencyMain(argc, argv);
+  return result;
+}
@@ -0,0 +1,128 @@
+///
+/// @file ConcurrencyMain.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by Royal Society of Secret Design
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+/// 		this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+/// 		this list of conditions and the following disclaimer in the documentation
+/// 		and/or other materials provided with the distribution.
+///    * Neither the name of Royal Society of Secret Design nor the names of its
+/// 		contributors may be used to endorse or promote products derived from
+/// 		this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+#ifndef RSSD_TEST_CONCURRENCY_CONCURRENCYMAIN_H
+#define RSSD_TEST_CONCURRENCY_CONCURRENCYMAIN_H
+
+#include "Concurrency"
+#include "test/Test.h"
+#include "test/concurrency/TestScheduler.h"
+#include "test/concurrency/TestWorkStealingDeque.h"
+
+namespace RSSD {
+namespace Core {
+namespace Concurrency {
+
+bool testNativeSuspension()
+{
+  Impl::NativeScheduler scheduler(2);
+  return testSuspension(scheduler);
+}
+
+bool testTbbSuspension()
+{
+  Impl::TbbScheduler scheduler;
+  return testSuspension(scheduler);
+}
+
+bool testNativeMemoization()
+{
+  Impl::NativeScheduler scheduler(2);
+  return testMemoization(scheduler);
+}
+
+bool testTbbMemoization()
+{
+  Impl::TbbScheduler scheduler;
+  return testMemoization(scheduler);
+}
+
+bool testNativeArena()
+{
+  Impl::NativeScheduler scheduler(2);
+  return testArena(scheduler);
+}
+
+bool testTbbArena()
+{
+  Impl::TbbScheduler scheduler;
+  return testArena(scheduler);
+}
+
+bool testNativePort()
+{
+  Impl::NativeScheduler scheduler(2);
+  return testPort(scheduler);
+}
+
+bool testTbbPort()
+{
+  Impl::TbbScheduler scheduler;
+  return testPort(scheduler);
+}
+
+bool testReadyOrder()
+{
+  /// Local vars
+  bool isPassed = false;
+  ReadyOrderBody body(isPassed);
+
+  boost::thread thread(body);
+  thread.join();
+  return isPassed;
+}
+
+int ConcurrencyMain(int argc, char **argv)
+{
+  /// Local vars
+  int failures = 0;
+
+  RSSD_TEST_RUN(failures, testWorkStealingDequeOrder);
+  RSSD_TEST_RUN(failures, testWorkStealingDequeConcurrent);
+  RSSD_TEST_RUN(failures, testNativeSuspension);
+  RSSD_TEST_RUN(failures, testTbbSuspension);
+  RSSD_TEST_RUN(failures, testNativeMemoization);
+  RSSD_TEST_RUN(failures, testTbbMemoization);
+  RSSD_TEST_RUN(failures, testNativeArena);
+  RSSD_TEST_RUN(failures, testTbbArena);
+  RSSD_TEST_RUN(failures, testNativePort);
+  RSSD_TEST_RUN(failures, testTbbPort);
+  RSSD_TEST_RUN(failures, testReadyOrder);
+  RSSD_TEST_RUN(failures, testTbbTaskIds);
+  return failures;
+}
+
+} /// namespace Concurrency
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_TEST_CONCURRENCY_CONCURRENCYMAIN_H
@@ -0,0 +1,393 @@
+///
+/// @file TestScheduler.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by Royal Society of Secret Design
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+/// 		this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+/// 		this list of conditions and the following disclaimer in the documentation
+/// 		and/or other materials provided with the distribution.
+///    * Neither the name of Royal Society of Secret Design nor the names of its
+/// 		contributors may be used to endorse or promote products derived from
+/// 		this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+#ifndef RSSD_TEST_CONCURRENCY_TESTSCHEDULER_H
+#define RSSD_TEST_CONCURRENCY_TESTSCHEDULER_H
+
+#include "Concurrency"
+#include "test/Test.h"
+
+namespace RSSD {
+namespace Core {
+namespace Concurrency {
+
+///
+/// @brief Shared state of the tasks of testSuspension().
+///
+struct SuspensionState
+{
+  SuspensionState() : mIsAllAwaiting(false), mIsSinkComplete(false)
+  {
+    this->mStarts = 0;
+    this->mAwaiting = 0;
+    this->mFinishes = 0;
+  }
+
+  static const uint32_t COUNT = 16; /// @note More tasks than threads
+
+  Completion mCompletions[COUNT];
+  std::atomic<uint32_t> mStarts; /// @note Runs from the top of a task
+  std::atomic<uint32_t> mAwaiting;
+  std::atomic<uint32_t> mFinishes; /// @note Runs past the await point
+  bool mIsAllAwaiting; /// @note Every task awaited before any completion was signalled
+  bool mIsSinkComplete; /// @note The successor of every task saw all of them finished
+}; /// struct SuspensionState
+
+struct AwaitingTask
+{
+  AwaitingTask(SuspensionState *state, const uint32_t index) : mState(state), mIndex(index) {}
+  void operator()(Frame frame)
+  {
+    RSSD_TASK_BEGIN();
+    ++this->mState->mStarts;
+    ++this->mState->mAwaiting;
+    RSSD_TASK_AWAIT(this->mState->mCompletions[this->mIndex]);
+    ++this->mState->mFinishes;
+    RSSD_TASK_END();
+  }
+
+  SuspensionState *mState;
+  uint32_t mIndex;
+}; /// struct AwaitingTask
+
+struct SinkTask
+{
+  SinkTask(SuspensionState *state) : mState(state) {}
+  void operator()(Frame frame) { this->mState->mIsSinkComplete = (this->mState->mFinishes == SuspensionState::COUNT); }
+
+  SuspensionState *mState;
+}; /// struct SinkTask
+
+///
+/// @brief Signals every completion once all tasks await, or after a second.
+///
+struct SignalLoop
+{
+  SignalLoop(SuspensionState &state) : mState(state) {}
+  void operator()() const
+  {
+    for (uint32_t attempt = 0; (attempt < 1000) && !this->mState.mIsAllAwaiting; ++attempt)
+    {
+      this->mState.mIsAllAwaiting = (this->mState.mAwaiting == SuspensionState::COUNT);
+      if (!this->mState.mIsAllAwaiting) { boost::this_thread::sleep(boost::posix_time::milliseconds(1)); }
+    }
+    for (uint32_t index = 0; index < SuspensionState::COUNT; ++index)
+    {
+      this->mState.mCompletions[index].signal();
+    }
+  }
+
+  SuspensionState &mState;
+}; /// struct SignalLoop
+
+///
+/// @note Tasks that await a pending Completion give their thread up: all
+///   of them await at once although there are fewer threads, and each one
+///   resumes at its await point rather than running again from the top.
+///
+template <typename SCHEDULER>
+bool testSuspension(SCHEDULER &scheduler)
+{
+  /// Local vars
+  SuspensionState state;
+  SignalLoop signalLoop(state);
+  typename SCHEDULER::TaskType::Pointer sink(new typename SCHEDULER::TaskType());
+
+  for (uint32_t index = 0; index < SuspensionState::COUNT; ++index)
+  {
+    typename SCHEDULER::TaskType::Pointer task(new typename SCHEDULER::TaskType());
+    task->setFunctor(AwaitingTask(&state, index));
+    RSSD_TEST_CHECK(scheduler.registerTask(task));
+    sink->addDependency(task->getTaskId());
+  }
+  sink->setFunctor(SinkTask(&state));
+  RSSD_TEST_CHECK(scheduler.registerTask(sink));
+
+  boost::thread signaller(signalLoop);
+  scheduler.run();
+  signaller.join();
+  scheduler.clear();
+
+  RSSD_TEST_CHECK(state.mIsAllAwaiting);
+  RSSD_TEST_CHECK(state.mStarts == SuspensionState::COUNT);
+  RSSD_TEST_CHECK(state.mFinishes == SuspensionState::COUNT);
+  RSSD_TEST_CHECK(state.mIsSinkComplete);
+  return true;
+}
+
+struct CountingTask
+{
+  CountingTask(uint32_t *runs) : mRuns(runs) {}
+  void operator()(Frame frame) { ++*this->mRuns; }
+
+  uint32_t *mRuns;
+}; /// struct CountingTask
+
+///
+/// @note A task whose declared inputs are unchanged since its last run is
+///   skipped, and so leaves its own output version, and its dependents,
+///   unchanged. A task without inputs always runs. Pipelined runs apply
+///   the same rule to each frame slot.
+///
+template <typename SCHEDULER>
+bool testMemoization(SCHEDULER &scheduler)
+{
+  /// Local vars
+  Version block;
+  uint32_t runs[3] = { 0, 0, 0 };
+  typename SCHEDULER::TaskType::Pointer reader(new typename SCHEDULER::TaskType(true));
+  typename SCHEDULER::TaskType::Pointer dependent(new typename SCHEDULER::TaskType(true, Task::Priority::MEDIUM, reader->getTaskId()));
+  typename SCHEDULER::TaskType::Pointer always(new typename SCHEDULER::TaskType(true, Task::Priority::MEDIUM, dependent->getTaskId()));
+
+  reader->setFunctor(CountingTask(&runs[0]));
+  reader->addInput(block);
+  dependent->setFunctor(CountingTask(&runs[1]));
+  dependent->addInput(reader->getOutputVersion());
+  always->setFunctor(CountingTask(&runs[2]));
+  RSSD_TEST_CHECK(scheduler.registerTask(reader));
+  RSSD_TEST_CHECK(scheduler.registerTask(dependent));
+  RSSD_TEST_CHECK(scheduler.registerTask(always));
+
+  for (uint32_t run = 0; run < 10; ++run)
+  {
+    scheduler.run();
+  }
+  RSSD_TEST_CHECK((runs[0] == 1) && (runs[1] == 1) && (runs[2] == 10));
+
+  block.increment();
+  for (uint32_t run = 0; run < 10; ++run)
+  {
+    scheduler.run();
+  }
+  RSSD_TEST_CHECK((runs[0] == 2) && (runs[1] == 2) && (runs[2] == 20));
+
+  /// Pipelined frames reuse outputs per frame slot. A new slot count
+  /// forgets what every slot has seen, so the reader runs once per slot;
+  /// after that, nothing runs again while the block is unchanged.
+  scheduler.setFramesInFlight(3);
+  scheduler.pipeline(5);
+  const uint32_t dependentRuns = runs[1];
+  scheduler.pipeline(5);
+  scheduler.clear();
+  RSSD_TEST_CHECK((runs[0] == 5) && (runs[1] == dependentRuns) && (runs[2] == 30));
+  return true;
+}
+
+struct ArenaTask
+{
+  ArenaTask(uint32_t *misses) : mMisses(misses) {}
+  void operator()(Frame frame)
+  {
+    FrameArena *arena = FrameArena::getCurrent();
+    if (!arena) { ++*this->mMisses; return; }
+    arena->allocate(FrameArena::DEFAULT_CHUNK_SIZE);
+  }
+
+  uint32_t *mMisses;
+}; /// struct ArenaTask
+
+///
+/// @note Tasks allocate from the arena of their frame slot, which is reset
+///   as each frame retires, so the arenas stay a few chunks per lane however
+///   many frames run.
+///
+template <typename SCHEDULER>
+bool testArena(SCHEDULER &scheduler)
+{
+  /// Local vars
+  uint32_t misses = 0;
+  const uint32_t lanes = scheduler.getWorkerCount() + 1;
+  const uint32_t frameCount = 16 * lanes;
+  typename SCHEDULER::TaskType::Pointer task(new typename SCHEDULER::TaskType(true));
+
+  task->setFunctor(ArenaTask(&misses));
+  RSSD_TEST_CHECK(scheduler.registerTask(task));
+  scheduler.setFramesInFlight(2);
+  scheduler.pipeline(frameCount);
+  for (uint32_t run = 0; run < frameCount; ++run)
+  {
+    scheduler.run();
+  }
+  scheduler.clear();
+  RSSD_TEST_CHECK(misses == 0);
+
+  const size_t capacity = scheduler.getArena(0).getCapacity() + scheduler.getArena(1).getCapacity();
+  RSSD_TEST_CHECK(capacity <= 2 * 4 * lanes * FrameArena::DEFAULT_CHUNK_SIZE);
+  return true;
+}
+
+struct ProducerTask
+{
+  ProducerTask(Port<uint64_t> *port) : mPort(port) {}
+  void operator()(Frame frame) { (*this->mPort)[frame] = frame.mIndex * 2; }
+
+  Port<uint64_t> *mPort;
+}; /// struct ProducerTask
+
+struct ConsumerTask
+{
+  ConsumerTask(const Port<uint64_t> *port, uint32_t *runs, uint32_t *misses) : mPort(port), mRuns(runs), mMisses(misses) {}
+  void operator()(Frame frame)
+  {
+    ++*this->mRuns;
+    if ((*this->mPort)[frame] != frame.mIndex * 2) { ++*this->mMisses; }
+  }
+
+  const Port<uint64_t> *mPort;
+  uint32_t *mRuns;
+  uint32_t *mMisses;
+}; /// struct ConsumerTask
+
+///
+/// @note A consumer connected to a Port runs after the producer of each
+///   frame and reads the value that frame produced, whatever the frames in
+///   flight.
+///
+template <typename SCHEDULER>
+bool testPort(SCHEDULER &scheduler)
+{
+  /// Local vars
+  const uint32_t frameCount = 8;
+  uint32_t runs = 0;
+  uint32_t misses = 0;
+  Port<uint64_t> port(2);
+  typename SCHEDULER::TaskType::Pointer producer(new typename SCHEDULER::TaskType(true));
+  typename SCHEDULER::TaskType::Pointer consumer(new typename SCHEDULER::TaskType(true));
+
+  producer->setFunctor(ProducerTask(&port));
+  consumer->setFunctor(ConsumerTask(&port, &runs, &misses));
+  RSSD_TEST_CHECK(!port.connect(*consumer));
+  port.setProducer(*producer);
+  RSSD_TEST_CHECK(port.connect(*consumer));
+  RSSD_TEST_CHECK(!port.connect(*consumer));
+  RSSD_TEST_CHECK(consumer->hasDependency(producer->getTaskId()) && (consumer->getInputs().size() == 1));
+  RSSD_TEST_CHECK(scheduler.registerTask(producer));
+  RSSD_TEST_CHECK(scheduler.registerTask(consumer));
+
+  scheduler.setFramesInFlight(2);
+  scheduler.pipeline(frameCount, Frame(1));
+  scheduler.clear();
+  RSSD_TEST_CHECK((runs == frameCount) && (misses == 0));
+  return true;
+}
+
+struct OrderedTask
+{
+  OrderedTask(uint32_t *starts, uint32_t *next) : mStarts(starts), mNext(next) {}
+  void operator()(Frame frame) { *this->mStarts = (*this->mNext)++; }
+
+  uint32_t *mStarts;
+  uint32_t *mNext;
+}; /// struct OrderedTask
+
+///
+/// @note Ready tasks start in priority order, and within a priority level
+///   a task on a longer path starts ahead of a sibling on a shorter one,
+///   even if the sibling became ready first.
+///
+bool testTbbReadyOrder()
+{
+  /// Local vars
+  Impl::TbbScheduler scheduler;
+  uint32_t starts[5] = { 0, 0, 0, 0, 0 };
+  uint32_t next = 0;
+  Impl::TbbScheduler::TaskType::Pointer low(new Impl::TbbScheduler::TaskType(false, Task::Priority::LOW));
+  Impl::TbbScheduler::TaskType::Pointer shortPath(new Impl::TbbScheduler::TaskType());
+  Impl::TbbScheduler::TaskType::Pointer longPath(new Impl::TbbScheduler::TaskType());
+  Impl::TbbScheduler::TaskType::Pointer longTail(new Impl::TbbScheduler::TaskType(false, Task::Priority::MEDIUM, longPath->getTaskId()));
+  Impl::TbbScheduler::TaskType::Pointer high(new Impl::TbbScheduler::TaskType(false, Task::Priority::HIGH));
+  Impl::TbbScheduler::TaskType::Pointer tasks[5] = { low, shortPath, longPath, longTail, high };
+
+  for (uint32_t index = 0; index < 5; ++index)
+  {
+    tasks[index]->setFunctor(OrderedTask(&starts[index], &next));
+    tasks[index]->setDuration(10);
+    RSSD_TEST_CHECK(scheduler.registerTask(tasks[index]));
+  }
+  longTail->setDuration(1000);
+  scheduler.run();
+
+  RSSD_TEST_CHECK(next == 5);
+  RSSD_TEST_CHECK(starts[4] < starts[2]);
+  RSSD_TEST_CHECK(starts[2] < starts[1]);
+  RSSD_TEST_CHECK(starts[1] < starts[0]);
+  return true;
+}
+
+///
+/// @brief Runs testTbbReadyOrder() on a thread of its own with a single
+///   TBB thread, so that tasks start in the order they are dispatched.
+///
+struct ReadyOrderBody
+{
+  ReadyOrderBody(bool &isPassed) : mIsPassed(isPassed) {}
+  void operator()() const
+  {
+    tbb::task_scheduler_init init(1);
+    this->mIsPassed = testTbbReadyOrder();
+  }
+
+  bool &mIsPassed;
+}; /// struct ReadyOrderBody
+
+struct TaskIdBody
+{
+  TaskIdBody(uint32_t &taskId) : mTaskId(taskId) {}
+  void operator()() const { this->mTaskId = Impl::TbbScheduler::TaskType().getTaskId(); }
+
+  uint32_t &mTaskId;
+}; /// struct TaskIdBody
+
+///
+/// @note Task IDs stay dense whichever thread creates the task, so the
+///   graph's index pages follow the number of tasks.
+///
+bool testTbbTaskIds()
+{
+  /// Local vars
+  uint32_t taskIds[3] = { 0, 0, 0 };
+
+  for (uint32_t index = 0; index < 3; ++index)
+  {
+    TaskIdBody body(taskIds[index]);
+    boost::thread thread(body);
+    thread.join();
+  }
+  RSSD_TEST_CHECK((taskIds[1] == taskIds[0] + 1) && (taskIds[2] == taskIds[1] + 1));
+  return true;
+}
+
+} /// namespace Concurrency
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_TEST_CONCURRENCY_TESTSCHEDULER_H
@@ -0,0 +1,134 @@
+///
+/// @file TestWorkStealingDeque.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by Royal Society of Secret Design
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+/// 		this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+/// 		this list of conditions and the following disclaimer in the documentation
+/// 		and/or other materials provided with the distribution.
+///    * Neither the name of Royal Society of Secret Design nor the names of its
+/// 		contributors may be used to endorse or promote products derived from
+/// 		this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+#ifndef RSSD_TEST_CONCURRENCY_TESTWORKSTEALINGDEQUE_H
+#define RSSD_TEST_CONCURRENCY_TESTWORKSTEALINGDEQUE_H
+
+#include "concurrency/native/WorkStealingDeque.h"
+#include "test/Test.h"
+
+namespace RSSD {
+namespace Core {
+namespace Concurrency {
+
+typedef Impl::WorkStealingDeque<uint32_t> TestDeque;
+
+struct StealLoop
+{
+  StealLoop(TestDeque &deque, std::atomic<uint32_t> *taken, const std::atomic<bool> &isDone) : mDeque(deque), mTaken(taken), mIsDone(isDone) {}
+  void operator()() const
+  {
+    uint32_t item = 0;
+    while (!this->mIsDone.load() || !this->mDeque.empty())
+    {
+      if (this->mDeque.steal(item)) { ++this->mTaken[item]; }
+    }
+  }
+
+  TestDeque &mDeque;
+  std::atomic<uint32_t> *mTaken; /// @note [Item] => Times taken
+  const std::atomic<bool> &mIsDone;
+}; /// struct StealLoop
+
+///
+/// @note The owner's end is LIFO and the thieves' end FIFO, across growth
+///   of the underlying array.
+///
+bool testWorkStealingDequeOrder()
+{
+  /// Local vars
+  TestDeque deque(4);
+  uint32_t item = 0;
+
+  for (uint32_t value = 1; value <= 1000; ++value)
+  {
+    deque.push(value);
+  }
+  RSSD_TEST_CHECK(deque.size() == 1000);
+  RSSD_TEST_CHECK(deque.steal(item) && (item == 1));
+  RSSD_TEST_CHECK(deque.pop(item) && (item == 1000));
+  RSSD_TEST_CHECK(deque.steal(item) && (item == 2));
+  RSSD_TEST_CHECK(deque.pop(item) && (item == 999));
+  while (deque.pop(item)) {}
+  RSSD_TEST_CHECK(deque.empty());
+  RSSD_TEST_CHECK(!deque.steal(item));
+  return true;
+}
+
+///
+/// @note The owner pushes and pops while three thieves steal; every item
+///   must be taken exactly once.
+///
+bool testWorkStealingDequeConcurrent()
+{
+  /// Local vars
+  const uint32_t count = 200000;
+  TestDeque deque;
+  boost::scoped_array<std::atomic<uint32_t> > taken(new std::atomic<uint32_t>[count]);
+  std::atomic<bool> isDone(false);
+  uint32_t item = 0;
+  uint32_t duplicates = 0;
+  uint32_t missing = 0;
+
+  for (uint32_t index = 0; index < count; ++index)
+  {
+    taken[index] = 0;
+  }
+  boost::thread_group thieves;
+  for (uint32_t index = 0; index < 3; ++index)
+  {
+    thieves.create_thread(StealLoop(deque, taken.get(), isDone));
+  }
+  for (uint32_t index = 0; index < count; ++index)
+  {
+    deque.push(index);
+    if (((index % 3) == 0) && deque.pop(item)) { ++taken[item]; }
+  }
+  while (deque.pop(item)) { ++taken[item]; }
+  isDone = true;
+  thieves.join_all();
+
+  for (uint32_t index = 0; index < count; ++index)
+  {
+    if (taken[index] > 1) { ++duplicates; }
+    if (!taken[index]) { ++missing; }
+  }
+  RSSD_TEST_CHECK(!duplicates);
+  RSSD_TEST_CHECK(!missing);
+  return true;
+}
+
+} /// namespace Concurrency
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_TEST_CONCURRENCY_TESTWORKSTEALINGDEQUE_H
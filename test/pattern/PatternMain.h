@@ -0,0 +1,63 @@
+///
+/// @file PatternMain.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by Royal Society of Secret Design
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+/// 		this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+/// 		this list of conditions and the following disclaimer in the documentation
+/// 		and/or other materials provided with the distribution.
+///    * Neither the name of Royal Society of Secret Design nor the names of its
+/// 		contributors may be used to endorse or promote products derived from
+/// 		this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+#ifndef RSSD_TEST_PATTERN_PATTERNMAIN_H
+#define RSSD_TEST_PATTERN_PATTERNMAIN_H
+
+#include "test/Test.h"
+#include "test/pattern/TestPublisher.h"
+#include "test/pattern/TestSignal.h"
+#include "test/pattern/TestSlotMap.h"
+
+namespace RSSD {
+namespace Core {
+namespace Pattern {
+
+int PatternMain(int argc, char **argv)
+{
+  /// Local vars
+  int failures = 0;
+
+  RSSD_TEST_RUN(failures, testSlotMapGenerations);
+  RSSD_TEST_RUN(failures, testSlotMapSwapAndPop);
+  RSSD_TEST_RUN(failures, testSlotManagerGenerations);
+  RSSD_TEST_RUN(failures, testPublisherReentrantReclamation);
+  RSSD_TEST_RUN(failures, testPublisherConcurrentReclamation);
+  RSSD_TEST_RUN(failures, testSignalThrowingDelegate);
+  return failures;
+}
+
+} /// namespace Pattern
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_TEST_PATTERN_PATTERNMAIN_H
@@ -0,0 +1,172 @@
+///
+/// @file TestPublisher.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by Royal Society of Secret Design
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+/// 		this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+/// 		this list of conditions and the following disclaimer in the documentation
+/// 		and/or other materials provided with the distribution.
+///    * Neither the name of Royal Society of Secret Design nor the names of its
+/// 		contributors may be used to endorse or promote products derived from
+/// 		this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+#ifndef RSSD_TEST_PATTERN_TESTPUBLISHER_H
+#define RSSD_TEST_PATTERN_TESTPUBLISHER_H
+
+#include "Pattern"
+#include "test/Test.h"
+
+namespace RSSD {
+namespace Core {
+namespace Pattern {
+
+///
+/// @brief Publisher that reports how many snapshots await reclamation.
+///
+class TestPublisher : public Publisher<uint32_t>
+{
+public:
+  size_t getRetiredCount()
+  {
+    boost::mutex::scoped_lock lock(this->mWriteMutex);
+    return (this->mRetired[0].size() + this->mRetired[1].size());
+  }
+
+  static const size_t LIMIT = Publisher<uint32_t>::RETIRED_LIMIT;
+}; /// class TestPublisher
+
+class CountingSubscriber : public Publisher<uint32_t>::Subscriber
+{
+public:
+  CountingSubscriber() { this->mCount = 0; }
+  virtual void onNotification(uint32_t &publication) { ++this->mCount; }
+
+  std::atomic<uint32_t> mCount;
+}; /// class CountingSubscriber
+
+///
+/// @brief Replaces itself with another subscriber on its first notification.
+///
+class ReplacingSubscriber : public Publisher<uint32_t>::Subscriber
+{
+public:
+  ReplacingSubscriber(TestPublisher &publisher, const Publisher<uint32_t>::Subscriber::Pointer &other) :
+    mPublisher(publisher), mOther(other), mRetired(0) {}
+  virtual void onNotification(uint32_t &publication)
+  {
+    this->mPublisher.unregisterSubscriber(this);
+    this->mPublisher.registerSubscriber(this->mOther);
+    this->mRetired = this->mPublisher.getRetiredCount();
+  }
+
+  TestPublisher &mPublisher;
+  Publisher<uint32_t>::Subscriber::Pointer mOther;
+  size_t mRetired; /// @note Snapshots awaiting reclamation inside the notification
+}; /// class ReplacingSubscriber
+
+struct PublishLoop
+{
+  PublishLoop(TestPublisher &publisher, const std::atomic<bool> &isStopped) : mPublisher(publisher), mIsStopped(isStopped) {}
+  void operator()() const
+  {
+    uint32_t publication = 0;
+    while (!this->mIsStopped.load()) { this->mPublisher.publish(++publication); }
+  }
+
+  TestPublisher &mPublisher;
+  const std::atomic<bool> &mIsStopped;
+}; /// struct PublishLoop
+
+///
+/// @note Snapshots replaced while a publish() reads them are kept until it
+///   has finished, and freed by the writes that follow.
+///
+bool testPublisherReentrantReclamation()
+{
+  /// Local vars
+  TestPublisher publisher;
+  SharedPointer<CountingSubscriber> other(new CountingSubscriber());
+  SharedPointer<ReplacingSubscriber> replacing(new ReplacingSubscriber(publisher, other));
+  uint32_t publication = 1;
+
+  RSSD_TEST_CHECK(publisher.registerSubscriber(replacing));
+  publisher.publish(publication);
+  RSSD_TEST_CHECK(replacing->mRetired == 2);
+  RSSD_TEST_CHECK(other->mCount == 0);
+  RSSD_TEST_CHECK(!publisher.hasSubscriber(replacing.get()) && publisher.hasSubscriber(other.get()));
+
+  publisher.publish(publication);
+  RSSD_TEST_CHECK(other->mCount == 1);
+
+  /// No reader is left, so two writes free everything retired before them
+  RSSD_TEST_CHECK(publisher.registerSubscriber(replacing));
+  RSSD_TEST_CHECK(publisher.unregisterSubscriber(replacing.get()));
+  RSSD_TEST_CHECK(publisher.getRetiredCount() <= 1);
+  return true;
+}
+
+///
+/// @note Subscribers (un)registered while other threads publish without
+///   pause; retired snapshots must stay bounded throughout.
+///
+bool testPublisherConcurrentReclamation()
+{
+  /// Local vars
+  TestPublisher publisher;
+  SharedPointer<CountingSubscriber> persistent(new CountingSubscriber());
+  SharedPointer<CountingSubscriber> transient(new CountingSubscriber());
+  std::atomic<bool> isStopped(false);
+  size_t maxRetired = 0;
+  bool isRegistered = true;
+
+  publisher.registerSubscriber(persistent);
+  boost::thread_group publishers;
+  for (uint32_t index = 0; index < 3; ++index)
+  {
+    publishers.create_thread(PublishLoop(publisher, isStopped));
+  }
+  for (uint32_t iteration = 0; iteration < 20000; ++iteration)
+  {
+    isRegistered = isRegistered && publisher.registerSubscriber(transient);
+    isRegistered = isRegistered && publisher.unregisterSubscriber(transient.get());
+    maxRetired = std::max(maxRetired, publisher.getRetiredCount());
+  }
+  isStopped = true;
+  publishers.join_all();
+
+  RSSD_TEST_CHECK(isRegistered);
+  RSSD_TEST_CHECK(maxRetired <= TestPublisher::LIMIT);
+  RSSD_TEST_CHECK(persistent->mCount > 0);
+  RSSD_TEST_CHECK(publisher.getSubscriberCount() == 1);
+
+  RSSD_TEST_CHECK(publisher.registerSubscriber(transient));
+  RSSD_TEST_CHECK(publisher.unregisterSubscriber(transient.get()));
+  RSSD_TEST_CHECK(publisher.getRetiredCount() <= 1);
+  return true;
+}
+
+} /// namespace Pattern
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_TEST_PATTERN_TESTPUBLISHER_H
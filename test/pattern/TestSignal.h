@@ -0,0 +1,106 @@
+///
+/// @file TestSignal.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by Royal Society of Secret Design
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+/// 		this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+/// 		this list of conditions and the following disclaimer in the documentation
+/// 		and/or other materials provided with the distribution.
+///    * Neither the name of Royal Society of Secret Design nor the names of its
+/// 		contributors may be used to endorse or promote products derived from
+/// 		this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+
+#ifndef RSSD_TEST_PATTERN_TESTSIGNAL_H
+#define RSSD_TEST_PATTERN_TESTSIGNAL_H
+
+#include <stdexcept>
+#include "Pattern"
+#include "test/Test.h"
+
+namespace RSSD {
+namespace Core {
+namespace Pattern {
+
+struct CountingReceiver
+{
+  CountingReceiver() : mCount(0) {}
+  void onValue(uint32_t &value) { ++this->mCount; }
+
+  uint32_t mCount;
+}; /// struct CountingReceiver
+
+///
+/// @brief Disconnects itself, then throws.
+///
+struct ThrowingReceiver
+{
+  void onValue(uint32_t &value)
+  {
+    this->mConnection.disconnect();
+    throw std::runtime_error("ThrowingReceiver");
+  }
+
+  Signal<uint32_t>::Connection mConnection;
+}; /// struct ThrowingReceiver
+
+///
+/// @note A delegate that throws out of emit() leaves the Signal as if
+///   emit() had returned: the disconnection it requested takes effect, and
+///   later disconnections are immediate again.
+///
+bool testSignalThrowingDelegate()
+{
+  /// Local vars
+  Signal<uint32_t> signal;
+  CountingReceiver counter;
+  ThrowingReceiver thrower;
+  uint32_t value = 0;
+  bool isThrown = false;
+
+  const Signal<uint32_t>::Connection connection = signal.connect(Delegate<uint32_t>::bind<CountingReceiver, &CountingReceiver::onValue>(&counter));
+  thrower.mConnection = signal.connect(Delegate<uint32_t>::bind<ThrowingReceiver, &ThrowingReceiver::onValue>(&thrower));
+  RSSD_TEST_CHECK(signal.size() == 2);
+
+  try
+  {
+    signal.emit(value);
+  }
+  catch (const std::runtime_error &exception)
+  {
+    isThrown = true;
+  }
+  RSSD_TEST_CHECK(isThrown && (counter.mCount == 1));
+  RSSD_TEST_CHECK(signal.size() == 1);
+
+  signal.emit(value);
+  RSSD_TEST_CHECK(counter.mCount == 2);
+  RSSD_TEST_CHECK(signal.disconnect(connection) && (signal.size() == 0));
+  return true;
+}
+
+} /// namespace Pattern
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_TEST_PATTERN_TESTSIGNAL_H
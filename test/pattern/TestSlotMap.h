@@ -0,0 +1,129 @@
+///
+/// @file TestSlotMap.h
+/// @author Mancobian Poemandres
+/// @license BSD License
+///
+/// Copyright (c) MMX by Royal Society of Secret Design
+/// All rights reserved
+///
+/// Redistribution and use in source and binary forms, with or without
+/// modification, are permitted provided that the following conditions are met:
+///
+///    * Redistributions of source code must retain the above copyright notice,
+/// 		this list of conditions and the following disclaimer.
+///    * Redistributions in binary form must reproduce the above copyright notice,
+/// 		this list of conditions and the following disclaimer in the documentation
+/// 		and/or other materials provided with the distribution.
+///    * Neither the name of Royal Society of Secret Design nor the names of its
+/// 		contributors may be used to endorse or promote products derived from
+/// 		this software without specific prior written permission.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+/// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+/// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+/// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+/// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+/// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+/// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+/// USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///
+
+#ifndef RSSD_TEST_PATTERN_TESTSLOTMAP_H
+#define RSSD_TEST_PATTERN_TESTSLOTMAP_H
+
+#include "Pattern"
+#include "test/Test.h"
+
+namespace RSSD {
+namespace Core {
+namespace Pattern {
+
+///
+/// @note A handle taken before its key was erased must not resolve to the
+///   value reinserted under the same key.
+///
+bool testSlotMapGenerations()
+{
+  /// Local vars
+  SlotMap<uint32_t> map;
+
+  const SlotMap<uint32_t>::Handle first = map.insert(5, 50);
+  RSSD_TEST_CHECK(first.isValid());
+  RSSD_TEST_CHECK(!map.insert(5, 51).isValid());
+  RSSD_TEST_CHECK(map.find(first) && (*map.find(first) == 50));
+
+  RSSD_TEST_CHECK(map.erase(5));
+  RSSD_TEST_CHECK(!map.find(first));
+  RSSD_TEST_CHECK(!map.contains(5));
+
+  const SlotMap<uint32_t>::Handle second = map.insert(5, 52);
+  RSSD_TEST_CHECK(second.isValid() && (second.mGeneration != first.mGeneration));
+  RSSD_TEST_CHECK(!map.find(first));
+  RSSD_TEST_CHECK(map.find(second) && (*map.find(second) == 52));
+  RSSD_TEST_CHECK(map.getHandle(5).mGeneration == second.mGeneration);
+  return true;
+}
+
+///
+/// @note Erasing moves the last value into the hole; every other key must
+///   still resolve to its own value.
+///
+bool testSlotMapSwapAndPop()
+{
+  /// Local vars
+  SlotMap<uint32_t> map;
+  const uint32_t count = 3 * SlotMap<uint32_t>::PAGE_SIZE;
+
+  for (uint32_t key = 0; key < count; ++key)
+  {
+    RSSD_TEST_CHECK(map.insert(key * 7, key).isValid());
+  }
+  for (uint32_t key = 0; key < count; key += 2)
+  {
+    RSSD_TEST_CHECK(map.erase(key * 7));
+  }
+  RSSD_TEST_CHECK(map.size() == count / 2);
+  for (uint32_t key = 0; key < count; ++key)
+  {
+    const uint32_t *value = map.find(key * 7);
+    RSSD_TEST_CHECK((key % 2) ? (value && (*value == key)) : !value);
+  }
+  return true;
+}
+
+///
+/// @note Removing an item retires its handle; the slot is reused under a
+///   new generation, and the handles of moved items stay valid.
+///
+bool testSlotManagerGenerations()
+{
+  /// Local vars
+  SlotManager<uint32_t> manager;
+
+  const SlotManager<uint32_t>::Handle a = manager.add(1);
+  const SlotManager<uint32_t>::Handle b = manager.add(2);
+  const SlotManager<uint32_t>::Handle c = manager.add(3);
+  RSSD_TEST_CHECK((a != SlotManager<uint32_t>::INVALID) && (b != SlotManager<uint32_t>::INVALID) && (c != SlotManager<uint32_t>::INVALID));
+
+  RSSD_TEST_CHECK(manager.remove(a));
+  RSSD_TEST_CHECK(!manager.remove(a));
+  RSSD_TEST_CHECK(!manager.has(a) && !manager.get(a));
+  RSSD_TEST_CHECK(manager.get(b) && (*manager.get(b) == 2));
+  RSSD_TEST_CHECK(manager.get(c) && (*manager.get(c) == 3));
+
+  const SlotManager<uint32_t>::Handle d = manager.add(4);
+  RSSD_TEST_CHECK(SlotManager<uint32_t>::getIndex(d) == SlotManager<uint32_t>::getIndex(a));
+  RSSD_TEST_CHECK(SlotManager<uint32_t>::getGeneration(d) != SlotManager<uint32_t>::getGeneration(a));
+  RSSD_TEST_CHECK(!manager.get(a));
+  RSSD_TEST_CHECK(manager.get(d) && (*manager.get(d) == 4));
+  RSSD_TEST_CHECK(manager.size() == 3);
+  return true;
+}
+
+} /// namespace Pattern
+} /// namespace Core
+} /// namespace RSSD
+
+#endif /// RSSD_TEST_PATTERN_TESTSLOTMAP_H
@@ -69,6 +69,8 @@ public:
 
   static const uint64_t USEC_PER_SEC = 1000000;
   static const uint64_t USEC_PER_MSEC = 1000;
+  static const uint64_t NSEC_PER_SEC = 1000000000;
+  static const uint64_t NSEC_PER_USEC = 1000;
 }; // class Timer
 
 template <typename IMPL>
@@ -83,6 +85,9 @@ public:
   virtual void stop() { this->mImpl.stop(); }
   virtual void reset() { this->mImpl.reset(); }
   virtual uint64_t getMicroseconds() const { return this->mImpl.getMicroseconds(); };
+  /// @note Monotonic timestamp in integer nanoseconds; cheap enough to read
+  ///   around every task execution
+  static uint64_t now() { return IMPL::now(); }
 
 protected:
   IMPL mImpl;
@@ -48,3 +48,16 @@ uint64_t PosixTimer::getMicroseconds() const
 
 	return stop - start;
 }
+
+///
+/// @note CLOCK_MONOTONIC does not jump with wall clock changes and is read
+///   without a system call on Linux.
+///
+uint64_t PosixTimer::now()
+{
+	/// Local vars
+	timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return static_cast<uint64_t>(time.tv_sec) * Timer::NSEC_PER_SEC + static_cast<uint64_t>(time.tv_nsec);
+}
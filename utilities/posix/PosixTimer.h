@@ -34,6 +34,7 @@
 #define RSSD_CORE_TIMER_IMPL_POSIXTIMER_H
 
 #include <sys/time.h>
+#include <time.h>
 #include "System"
 #include "utilities/Timer.h"
 
@@ -51,6 +52,7 @@ public:
   void stop();
   void reset();
   uint64_t getMicroseconds() const;
+  static uint64_t now();
 
 protected:
   timeval _start, _stop;
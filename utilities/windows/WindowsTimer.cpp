@@ -1,4 +1,7 @@
 #include "WindowsTimer.h"
+#if RSSD_PLATFORM_WINDOWS
+#include <windows.h>
+#endif
 
 using namespace RSSD;
 using namespace RSSD::Core;
@@ -34,3 +37,19 @@ uint64_t WindowsTimer::getMicroseconds() const
 {
 	return static_cast<uint64_t>(0);
 }
+
+uint64_t WindowsTimer::now()
+{
+#if RSSD_PLATFORM_WINDOWS
+	/// Local vars
+	LARGE_INTEGER counter, frequency;
+
+	QueryPerformanceCounter(&counter);
+	QueryPerformanceFrequency(&frequency);
+	const uint64_t ticks = static_cast<uint64_t>(counter.QuadPart);
+	const uint64_t rate = static_cast<uint64_t>(frequency.QuadPart);
+	return (ticks / rate) * Timer::NSEC_PER_SEC + ((ticks % rate) * Timer::NSEC_PER_SEC) / rate;
+#else
+	return static_cast<uint64_t>(0);
+#endif
+}
@@ -50,6 +50,7 @@ public:
   virtual void stop();
   virtual void reset();
   virtual uint64_t getMicroseconds() const;
+  static uint64_t now();
 }; // class WindowsTimer
 
 } /// namespace Impl